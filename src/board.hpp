@@ -38,125 +38,2077 @@ public:
 
 class assigning_empty_value : public std::exception {};
 
+class unmaking_empty_position : public std::exception
+{
+public:
+  unmaking_empty_position(const POSITION pos) : pos(pos) {};
+
+  const POSITION pos;
+};
+
+// Types
+// the smallest unsigned integer with at least Bits bits
+template <int Bits>
+using bit_mask=std::conditional_t<Bits<=8,std::uint8_t,std::conditional_t<Bits<=16,std::uint16_t
+  ,std::conditional_t<Bits<=32,std::uint32_t,std::uint64_t>>>;
+
+// one bit per position of the 3x3 board, with bit n corresponding to POSITION n
+using board_mask=bit_mask<9>;
+
 // Constants
-const std::array<std::array<POSITION,3>,8> kWinningPositions={{
-  // rows
-  {{POSITION::kTopLeft,POSITION::kTopMiddle,POSITION::kTopRight}}
-  , {{POSITION::kMiddleLeft,POSITION::kMiddleMiddle,POSITION::kMiddleRight}}
-  , {{POSITION::kBottomLeft,POSITION::kBottomMiddle,POSITION::kBottomRight}}
-  // columns
-  , {{POSITION::kTopLeft,POSITION::kMiddleLeft,POSITION::kBottomLeft}}
-  , {{POSITION::kTopMiddle,POSITION::kMiddleMiddle,POSITION::kBottomMiddle}}
-  , {{POSITION::kTopRight,POSITION::kMiddleRight,POSITION::kBottomRight}}
-  // diagonals
-  , {{POSITION::kTopLeft,POSITION::kMiddleMiddle,POSITION::kBottomRight}}
-  , {{POSITION::kBottomLeft,POSITION::kMiddleMiddle,POSITION::kTopRight}}
+// the value held by a position, indexed by (cross bit)|(nought bit)<<1
+constexpr std::array<VALUE,3> kPositionValues={{
+  VALUE::kEmpty
+  , VALUE::kCross
+  , VALUE::kNought
 }};
 
-// Classes
-class BoardElement
+// the number of 3x3 boards (3^9), the number of those which can be reached in a game, and the number of their classes of isometries
+constexpr int kRanks=19683;
+constexpr int kLegalPositions=5478;
+constexpr int kIsometryClasses=765;
+
+// Functions
+constexpr inline board_mask position_mask(const POSITION pos)
+{
+  //
+  // Create the mask of a single position of the 3x3 board
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to mask
+  //
+  // returns
+  // -------
+  // board_mask
+  //  - a mask with only the bit of pos set
+  //
+
+  return static_cast<board_mask>(1<<static_cast<int>(pos));
+}
+
+constexpr inline int count_winning_lines(const int rows, const int columns, const int in_row)
+{
+  //
+  // Count the winning combinations of a board
+  // A combination is in_row positions in a row, in a column, or on a diagonal in either direction
+  //
+  // parameters
+  // ----------
+  // rows,columns : const int
+  //  - the size of the board
+  // in_row : const int
+  //  - the number of positions in a row which win
+  //
+  // returns
+  // -------
+  // int
+  //  - the number of winning combinations
+  //
+
+  return rows*(columns-in_row+1)+(rows-in_row+1)*columns+2*(rows-in_row+1)*(columns-in_row+1);
+}
+
+constexpr inline int count_isometries(const int rows, const int columns)
+{
+  //
+  // Count the isometries of a board
+  // A square board has all eight of the dihedral group D4, while any other keeps its shape only under reflections and half turns
+  //
+  // parameters
+  // ----------
+  // rows,columns : const int
+  //  - the size of the board
+  //
+  // returns
+  // -------
+  // int
+  //  - the number of isometries
+  //
+
+  return rows==columns ? 8 : 4;
+}
+
+template <int M, int N, int K>
+constexpr inline std::array<std::array<POSITION,K>,count_winning_lines(M,N,K)> make_winning_positions(void)
+{
+  //
+  // Generate the winning combinations of a board of M rows and N columns, won with K positions in a row
+  // Combinations are ordered rows, columns, diagonals, then anti-diagonals, each by the position they start from
+  //
+  // returns
+  // -------
+  // std::array<std::array<POSITION,K>,count_winning_lines(M,N,K)>
+  //  - the positions of each winning combination
+  //
+
+  std::array<std::array<POSITION,K>,count_winning_lines(M,N,K)> lines={};
+  // the step in rows and columns between the positions of each direction, where anti-diagonals run up and to the right
+  const std::array<std::array<int,2>,4> steps={{{{0,1}},{{1,0}},{{1,1}},{{-1,1}}}};
+  size_t line=0;
+  for (const std::array<int,2> &step:steps)
+  {
+    for (int row=0;row<M;++row)
+    {
+      for (int col=0;col<N;++col)
+      {
+        // the combination must end on the board
+        const int last_row=row+(K-1)*step[0],last_col=col+(K-1)*step[1];
+        if (last_row<0||last_row>=M||last_col>=N) { continue; }
+        for (int itr=0;itr<K;++itr) { lines[line][itr]=static_cast<POSITION>((row+itr*step[0])*N+col+itr*step[1]); }
+        ++line;
+      }
+    }
+  }
+  return lines;
+}
+
+template <int M, int N, int K>
+constexpr inline std::array<bit_mask<M*N>,count_winning_lines(M,N,K)> make_winning_masks(void)
+{
+  //
+  // Create the mask form of the winning combinations of a board
+  //
+  // returns
+  // -------
+  // std::array<bit_mask<M*N>,count_winning_lines(M,N,K)>
+  //  - one mask per winning combination, in the order of make_winning_positions
+  //
+
+  constexpr int kLines=count_winning_lines(M,N,K);
+  const std::array<std::array<POSITION,K>,kLines> positions=make_winning_positions<M,N,K>();
+  std::array<bit_mask<M*N>,kLines> masks={};
+  for (int itr=0;itr<kLines;++itr)
+  {
+    for (const POSITION pos:positions[itr]) { masks[itr]|=static_cast<bit_mask<M*N>>(bit_mask<M*N>{1}<<static_cast<int>(pos)); }
+  }
+  return masks;
+}
+
+template <int M, int N, int K>
+constexpr inline std::array<bit_mask<count_winning_lines(M,N,K)>,M*N> make_position_lines(void)
+{
+  //
+  // Determine which winning combinations pass through each position of a board
+  //
+  // returns
+  // -------
+  // std::array<bit_mask<count_winning_lines(M,N,K)>,M*N>
+  //  - one mask per position, where bit n is set if the position is part of winning combination n
+  //
+
+  using line_mask=bit_mask<count_winning_lines(M,N,K)>;
+  constexpr int kLines=count_winning_lines(M,N,K);
+  const std::array<std::array<POSITION,K>,kLines> positions=make_winning_positions<M,N,K>();
+  std::array<line_mask,M*N> lines={};
+  for (int itr=0;itr<kLines;++itr)
+  {
+    for (const POSITION pos:positions[itr]) { lines[static_cast<int>(pos)]|=static_cast<line_mask>(line_mask{1}<<itr); }
+  }
+  return lines;
+}
+
+template <int M, int N>
+constexpr inline std::array<std::array<POSITION,M*N>,count_isometries(M,N)> make_isometry_positions(void)
+{
+  //
+  // Determine where each position of a board is moved to by each isometry
+  // On a square board, isometry n is n/4 reflections along the vertical axis followed by n%4 quarter turns counterclockwise
+  // Otherwise, isometry n is n/2 reflections along the vertical axis followed by n%2 half turns
+  //
+  // returns
+  // -------
+  // std::array<std::array<POSITION,M*N>,count_isometries(M,N)>
+  //  - the position each position is moved to, indexed by isometry then position
+  //
+
+  constexpr int kIsometries=count_isometries(M,N);
+  std::array<std::array<POSITION,M*N>,kIsometries> positions={};
+  for (int itr=0;itr<kIsometries;++itr)
+  {
+    for (int pos=0;pos<M*N;++pos)
+    {
+      int row=pos/N,col=pos%N;
+      if (itr/(kIsometries/2)==1) { col=N-1-col; }
+      if (M==N)
+      {
+        // a quarter turn counterclockwise takes the last column to the first row
+        for (int jtr=0;jtr<itr%4;++jtr)
+        {
+          const int turned=N-1-col;
+          col=row;
+          row=turned;
+        }
+      }
+      else if (itr%2==1)
+      {
+        row=M-1-row;
+        col=N-1-col;
+      }
+      positions[itr][pos]=static_cast<POSITION>(row*N+col);
+    }
+  }
+  return positions;
+}
+
+template <int M, int N>
+constexpr inline std::array<int,count_isometries(M,N)> make_inverse_isometries(void)
+{
+  //
+  // Determine the isometry which undoes each isometry of a board
+  //
+  // returns
+  // -------
+  // std::array<int,count_isometries(M,N)>
+  //  - the inverse of each isometry
+  //
+
+  constexpr int kIsometries=count_isometries(M,N);
+  const std::array<std::array<POSITION,M*N>,kIsometries> positions=make_isometry_positions<M,N>();
+  std::array<int,kIsometries> inverses={};
+  for (int itr=0;itr<kIsometries;++itr)
+  {
+    for (int jtr=0;jtr<kIsometries;++jtr)
+    {
+      bool inverse=true;
+      for (int pos=0;pos<M*N;++pos)
+      {
+        inverse=inverse&&static_cast<int>(positions[jtr][static_cast<int>(positions[itr][pos])])==pos;
+      }
+      if (inverse) { inverses[itr]=jtr; }
+    }
+  }
+  return inverses;
+}
+
+template <int M, int N>
+constexpr inline std::array<std::array<std::array<bit_mask<M*N>,(1<<N)>,M>,count_isometries(M,N)> make_isometry_rows(void)
+{
+  //
+  // Determine the mask each row of positions of a board is moved to by each isometry
+  // Allows a mask to be moved by one lookup per row, rather than one step per position
+  //
+  // returns
+  // -------
+  // std::array<std::array<std::array<bit_mask<M*N>,(1<<N)>,M>,count_isometries(M,N)>
+  //  - the moved mask, indexed by isometry, row, then the N bits of that row
+  //
+
+  using mask_type=bit_mask<M*N>;
+  constexpr int kIsometries=count_isometries(M,N);
+  const std::array<std::array<POSITION,M*N>,kIsometries> positions=make_isometry_positions<M,N>();
+  std::array<std::array<std::array<mask_type,(1<<N)>,M>,kIsometries> rows={};
+  for (int itr=0;itr<kIsometries;++itr)
+  {
+    for (int row=0;row<M;++row)
+    {
+      for (int bits=0;bits<(1<<N);++bits)
+      {
+        for (int col=0;col<N;++col)
+        {
+          if (bits>>col&1) { rows[itr][row][bits]|=static_cast<mask_type>(mask_type{1}<<static_cast<int>(positions[itr][row*N+col])); }
+        }
+      }
+    }
+  }
+  return rows;
+}
+
+constexpr inline std::uint64_t splitmix64(std::uint64_t &state)
+{
+  //
+  // Generate the next number of a splitmix64 sequence
+  //
+  // parameters
+  // ----------
+  // state : std::uint64_t &
+  //  - the state of the sequence, which is advanced
+  //
+  // returns
+  // -------
+  // std::uint64_t
+  //  - the next number of the sequence
+  //
+
+  std::uint64_t z=(state+=0x9E3779B97F4A7C15);
+  z=(z^(z>>30))*0xBF58476D1CE4E5B9;
+  z=(z^(z>>27))*0x94D049BB133111EB;
+  return z^(z>>31);
+}
+
+template <size_t Positions, size_t Isometries>
+constexpr inline std::array<std::array<std::array<std::uint64_t,Isometries>,Positions>,2> make_zobrist_keys(
+  const std::array<std::array<POSITION,Positions>,Isometries> &isometries)
+{
+  //
+  // Generate the Zobrist keys of a board for every isometry
+  // Each side has a key for each position, and the key of a position under an isometry is the key of the position it is moved to,
+  // so the hash of an isometry of a board is the hash of the board moved by that isometry
+  //
+  // parameters
+  // ----------
+  // isometries : const std::array<std::array<POSITION,Positions>,Isometries> &
+  //  - the position each position is moved to, indexed by isometry then position
+  //
+  // returns
+  // -------
+  // std::array<std::array<std::array<std::uint64_t,Isometries>,Positions>,2>
+  //  - the keys, indexed by side (VALUE::kCross (1) at 0), position, then isometry
+  //
+
+  std::array<std::array<std::uint64_t,Positions>,2> keys={};
+  std::uint64_t state=Positions;
+  for (std::array<std::uint64_t,Positions> &side:keys)
+  {
+    for (std::uint64_t &key:side) { key=splitmix64(state); }
+  }
+
+  std::array<std::array<std::array<std::uint64_t,Isometries>,Positions>,2> isometry_keys={};
+  for (size_t itr=0;itr<2;++itr)
+  {
+    for (size_t pos=0;pos<Positions;++pos)
+    {
+      for (size_t jtr=0;jtr<Isometries;++jtr)
+      {
+        isometry_keys[itr][pos][jtr]=keys[itr][static_cast<size_t>(isometries[jtr][pos])];
+      }
+    }
+  }
+  return isometry_keys;
+}
+
+// Classes
+template <int M, int N, int K>
+class BasicBoard;
+
+class LegalPositions
+{
+public:
+  LegalPositions();
+
+  // the legal index of each rank, or -1 if the board of that rank cannot be reached in a game
+  std::array<std::int16_t,kRanks> indices;
+  // the rank of each legal index
+  std::array<std::uint16_t,kLegalPositions> ranks;
+  // the class index of each rank, or -1 if the board of that rank cannot be reached in a game
+  std::array<std::int16_t,kRanks> classes;
+  // the rank of the smallest board of each class of isometries
+  std::array<std::uint16_t,kIsometryClasses> class_ranks;
+
+  [[nodiscard]] static const LegalPositions &get(void);
+};
+
+class CanonicalKey
+{
+public:
+  // identifies the board's class of isometries: the smallest encoding of the masks over all isometries
+  std::uint64_t key;
+  // the isometry taking the board to the encoding in key
+  int isometry;
+};
+
+class SolvedPosition
+{
+public:
+  // marks a rank in the table of solved positions which is never reached in a game
+  static constexpr std::int8_t kUnsolved=2;
+
+  // the value of the board to the side to move under perfect play: 1 for a win, 0 for a draw, and -1 for a loss
+  std::int8_t value;
+  // the moves of the side to move which achieve value
+  board_mask moves;
+};
+
+class BoardElement
+{
+public:
+  VALUE val;
+  POSITION pos;
+  size_t ind;
+
+  BoardElement();
+  BoardElement(const VALUE val, const POSITION pos, const size_t ind);
+  ~BoardElement();
+
+private:
+  bool check_range(const size_t idx);
+};
+
+template <int M, int N, int K>
+class BasicBoardIterator
+{
+  const BasicBoard<M,N,K> *board;
+  BoardElement elem;
+
+public:
+  using pointer=const BoardElement * const;
+  using reference=const BoardElement &;
+
+  using iterator_category=std::forward_iterator_tag;
+  using difference_type=std::ptrdiff_t;
+  using value_type=BoardElement;
+
+  BasicBoardIterator();
+  BasicBoardIterator(const BasicBoard<M,N,K> *board, const size_t ind);
+  BasicBoardIterator(const BasicBoardIterator &other);
+  BasicBoardIterator(BasicBoardIterator &&other);
+  ~BasicBoardIterator();
+
+  // assignment
+  BasicBoardIterator &operator=(BasicBoardIterator other);
+  // dereference
+  reference operator*() const;
+  pointer operator->() const;
+  // increment
+  BasicBoardIterator &operator++();
+  BasicBoardIterator operator++(int);
+  // comparison
+  template <int A, int B, int C>
+  friend bool operator==(const BasicBoardIterator<A,B,C> &lhs, const BasicBoardIterator<A,B,C> &rhs);
+  // swap
+  template <int A, int B, int C>
+  friend void swap(BasicBoardIterator<A,B,C> &first, BasicBoardIterator<A,B,C> &second) noexcept;
+};
+
+// iterates over the positions set in a mask, lowest first
+// masks of every board size are held in 64 bits, so one iterator serves them all
+class MaskIterator
+{
+  std::uint64_t mask;
+
+public:
+  using pointer=const POSITION *;
+  using reference=POSITION;
+
+  using iterator_category=std::forward_iterator_tag;
+  using difference_type=std::ptrdiff_t;
+  using value_type=POSITION;
+
+  MaskIterator(const std::uint64_t mask) : mask(mask) {};
+
+  // dereference
+  reference operator*() const;
+  // increment
+  MaskIterator &operator++();
+  MaskIterator operator++(int);
+  // comparison
+  friend inline bool operator==(const MaskIterator &lhs, const MaskIterator &rhs);
+  friend inline bool operator!=(const MaskIterator &lhs, const MaskIterator &rhs);
+};
+
+class MaskRange
+{
+  std::uint64_t mask;
+
+public:
+  MaskRange(const std::uint64_t mask) : mask(mask) {};
+
+  [[nodiscard]] MaskIterator begin(void) const { return MaskIterator(this->mask); };
+  [[nodiscard]] MaskIterator end(void) const { return MaskIterator(0); };
+};
+
+// a list of moves held in place, with room for at most Capacity moves
+template <size_t Capacity>
+class MoveList
+{
+public:
+  using iterator=POSITION *;
+  using const_iterator=const POSITION *;
+
+  MoveList() : moves(), count(0) {};
+  MoveList(const std::uint64_t mask);
+
+  void push_back(const POSITION pos);
+  void clear(void) { this->count=0; };
+
+  // iterators
+  [[nodiscard]] iterator begin(void) { return this->moves.data(); };
+  [[nodiscard]] iterator end(void) { return this->moves.data()+this->count; };
+  [[nodiscard]] const_iterator begin(void) const { return this->moves.data(); };
+  [[nodiscard]] const_iterator end(void) const { return this->moves.data()+this->count; };
+
+  // getters
+  [[nodiscard]] size_t size(void) const { return this->count; };
+  [[nodiscard]] bool empty(void) const { return this->count==0; };
+  [[nodiscard]] POSITION front(void) const { return this->moves[0]; };
+  [[nodiscard]] POSITION &operator[](const size_t idx) { return this->moves[idx]; };
+  [[nodiscard]] const POSITION &operator[](const size_t idx) const { return this->moves[idx]; };
+
+private:
+  std::array<POSITION,Capacity> moves;
+  size_t count;
+};
+
+// an m,n,k-game: a board of M rows and N columns, won by holding K positions in a row, in a column, or on a diagonal
+// positions are numbered along the rows, so POSITION names the positions of the 3x3 board, and any other is cast from its index
+template <int M, int N, int K>
+class BasicBoard
+{
+  static_assert(K>=2,"A board must not be won by its first move.");
+  static_assert(K<=M&&K<=N,"A board must be large enough to hold its winning combinations.");
+  static_assert(M*N<=64,"A board must fit in the masks of 64 bits.");
+
+public:
+  // one bit per position, with bit n corresponding to position n
+  using mask_type=bit_mask<M*N>;
+  // one bit per winning combination
+  using line_mask=bit_mask<count_winning_lines(M,N,K)>;
+
+  static constexpr int kRows=M,kColumns=N,kInRow=K,kPositions=M*N;
+  static constexpr int kLines=count_winning_lines(M,N,K);
+  // isometry n is as applied by make_isometry_positions, of which operator>>= and operator<<= apply the generators
+  static constexpr int kIsometries=count_isometries(M,N);
+  static constexpr mask_type kFullBoard=static_cast<mask_type>(~std::uint64_t{0}>>(64-kPositions));
+  static constexpr std::array<std::array<POSITION,K>,kLines> kWinningPositions=make_winning_positions<M,N,K>();
+  static constexpr std::array<mask_type,kLines> kWinningMasks=make_winning_masks<M,N,K>();
+  static constexpr std::array<line_mask,kPositions> kPositionLines=make_position_lines<M,N,K>();
+  static constexpr std::array<std::array<POSITION,kPositions>,kIsometries> kIsometryPositions=make_isometry_positions<M,N>();
+  static constexpr std::array<int,kIsometries> kInverseIsometries=make_inverse_isometries<M,N>();
+  static constexpr std::array<std::array<std::array<mask_type,(1<<N)>,M>,kIsometries> kIsometryRows=make_isometry_rows<M,N>();
+  static constexpr std::array<std::array<std::array<std::uint64_t,kIsometries>,kPositions>,2> kZobristKeys=make_zobrist_keys(
+    kIsometryPositions);
+
+  constexpr BasicBoard();
+  constexpr BasicBoard(const BasicBoard &other);
+  constexpr BasicBoard(BasicBoard &&other);
+
+  void assign_position(POSITION pos, const VALUE value);
+  ASSIGNMENT try_assign(const POSITION pos, const VALUE value) noexcept;
+  void make_move(const POSITION pos, const VALUE value);
+  void unmake_move(const POSITION pos);
+  constexpr void make_move_unchecked(const POSITION pos, const VALUE value) noexcept;
+  constexpr void unmake_move_unchecked(const POSITION pos, const VALUE value) noexcept;
+  constexpr void clear_board(void);
+  constexpr RESULT check_board(void) const;
+
+  // iterators
+  [[nodiscard]] BasicBoardIterator<M,N,K> begin(void) const;
+  [[nodiscard]] BasicBoardIterator<M,N,K> end(void) const;
+
+  // getters
+  [[nodiscard]] constexpr ITERATION get_plays(void) const;
+  [[nodiscard]] constexpr VALUE get_turn(void) const;
+  [[nodiscard]] constexpr mask_type get_mask(const VALUE val) const;
+  [[nodiscard]] constexpr mask_type get_empty(void) const;
+  [[nodiscard]] MaskRange empty_positions(void) const;
+  [[nodiscard]] int get_symmetries(void) const;
+  [[nodiscard]] mask_type get_distinct_empty(void) const;
+  [[nodiscard]] mask_type get_winning_moves(const VALUE val) const;
+  [[nodiscard]] mask_type get_blocking_moves(const VALUE val) const;
+  [[nodiscard]] int get_line_score(const VALUE val) const;
+  [[nodiscard]] CanonicalKey canonical_key(void) const;
+  [[nodiscard]] std::uint64_t hash(void) const;
+  [[nodiscard]] std::uint64_t symmetric_hash(void) const;
+  [[nodiscard]] int symmetric_isometry(void) const;
+  [[nodiscard]] constexpr int rank(void) const;
+  [[nodiscard]] int legal_index(void) const;
+  [[nodiscard]] int class_index(void) const;
+  [[nodiscard]] bool is_legal(void) const;
+
+  // factories
+  [[nodiscard]] static BasicBoard from_rank(const int rank);
+  [[nodiscard]] static BasicBoard from_legal_index(const int index);
+  [[nodiscard]] static BasicBoard from_class_index(const int index);
+  [[nodiscard]] constexpr VALUE get_value(const POSITION pos) const noexcept;
+  [[nodiscard]] const VALUE &at(const POSITION &pos);
+  [[nodiscard]] const VALUE &at(const POSITION &pos) const;
+  [[nodiscard]] const VALUE &operator[](const POSITION &pos);
+  [[nodiscard]] const VALUE &operator[](const POSITION &pos) const;
+
+  // geometry
+  [[nodiscard]] static constexpr mask_type position_mask(const POSITION pos);
+  [[nodiscard]] static constexpr mask_type apply_isometry(const mask_type mask, const int isometry);
+  [[nodiscard]] static constexpr POSITION apply_isometry(const POSITION pos, const int isometry);
+
+  // assignment
+  BasicBoard &operator=(BasicBoard other);
+  constexpr BasicBoard &operator>>=(const int n);
+  constexpr BasicBoard &operator<<=(int n);
+  // swap
+  template <int A, int B, int C>
+  friend void swap(BasicBoard<A,B,C> &first, BasicBoard<A,B,C> &second) noexcept;
+
+private:
+  ITERATION plays;
+  // one mask per side, a position is empty if it is set in neither
+  mask_type crosses,noughts;
+  // the number of positions each side holds in each of kWinningPositions, and the result they give
+  std::array<std::uint8_t,kLines> cross_lines,nought_lines;
+  // the lines each side holds all but one position of, with none held by the other side
+  line_mask cross_threats,nought_threats;
+  RESULT result;
+  // the Zobrist hash of the board moved by each isometry
+  std::array<std::uint64_t,kIsometries> hashes;
+
+  bool check_range(const POSITION pos) const;
+  constexpr void count_lines(void);
+  constexpr void update_threats(const size_t line) noexcept;
+  constexpr void hash_positions(void);
+  constexpr void toggle_hashes(const POSITION pos, const VALUE val) noexcept;
+  constexpr void isometry(const int isometry);
+};
+
+// the board of noughts and crosses
+using Board=BasicBoard<3,3,3>;
+using BoardIterator=BasicBoardIterator<3,3,3>;
+
+// Constants
+// the constants of the 3x3 board, for use outside of the board
+constexpr board_mask kFullBoard=Board::kFullBoard;
+constexpr std::array<std::array<POSITION,3>,8> kWinningPositions=Board::kWinningPositions;
+constexpr std::array<board_mask,8> kWinningMasks=Board::kWinningMasks;
+// the eight isometries of the board (the dihedral group D4)
+// isometry n is n/4 reflections followed by n%4 quater turns counterclockwise, as applied by operator>>= and operator<<=
+constexpr int kIsometries=Board::kIsometries;
+constexpr std::array<int,kIsometries> kInverseIsometries=Board::kInverseIsometries;
+
+// Inline Methods
+inline MaskIterator::reference MaskIterator::operator*() const
+{
+  //
+  // MaskIterator operator*
+  // Indirects to the lowest position set in the mask
+  //
+  // returns
+  // -------
+  // MaskIterator::reference
+  //  - the lowest position set in the mask
+  //
+
+  return static_cast<POSITION>(countr_zero(this->mask));
+}
+
+inline MaskIterator &MaskIterator::operator++()
+{
+  //
+  // MaskIterator operator++
+  // Removes the lowest position from the mask and returns the iterator
+  //
+  // returns
+  // -------
+  // MaskIterator &
+  //  - a reference *this
+  //
+
+  this->mask&=this->mask-1;
+  return *this;
+}
+
+inline MaskIterator MaskIterator::operator++(int)
+{
+  //
+  // MaskIterator operator++(int)
+  // Increments the iterator and returns a copy of the pre-incremented iterator
+  //
+  // returns
+  // -------
+  // MaskIterator
+  //  - a copy of *this before incrementing
+  //
+
+  MaskIterator res=*this;
+  ++*this;
+  return res;
+}
+
+template <size_t Capacity>
+inline MoveList<Capacity>::MoveList(const std::uint64_t mask) : MoveList()
+{
+  //
+  // MoveList class constructor
+  // Lists every position set in a mask
+  //
+  // parameters
+  // ----------
+  // mask : const std::uint64_t
+  //  - the positions to list, of which there can be at most Capacity
+  //
+
+  for (const POSITION pos:MaskRange(mask)) { this->moves[this->count++]=pos; }
+}
+
+template <size_t Capacity>
+inline void MoveList<Capacity>::push_back(const POSITION pos)
+{
+  //
+  // Add a move to the end of the list
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to add, which must fit in the Capacity of the list
+  //
+
+  this->moves[this->count++]=pos;
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K>::BasicBoardIterator() : board(nullptr), elem()
+{
+  //
+  // BoardIterator class default constructor
+  // this->board is set to nullptr and this->elem is set to its default
+  //
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K>::BasicBoardIterator(const BasicBoard<M,N,K> *board, const size_t ind) : board(board)
+{
+  //
+  // BoardIterator class constructor
+  // this->board is set to corresponding input. this->elem is constructed from the inputs
+  //
+  // parameters
+  // ----------
+  // board : const BasicBoard<M,N,K> *
+  //  - the board to iterate over
+  // ind : const size_t
+  //  - the index of the position to start from, where BasicBoard<M,N,K>::kPositions is the end of the board
+  //
+
+  // the element is set directly, as BoardElement only checks the range of the 3x3 board
+  this->elem.pos=static_cast<POSITION>(ind);
+  this->elem.ind=ind;
+  this->elem.val=ind<BasicBoard<M,N,K>::kPositions ? (*board)[this->elem.pos] : VALUE::kEmpty;
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K>::BasicBoardIterator(const BasicBoardIterator<M,N,K> &other) : board(other.board), elem(other.elem)
+{
+  //
+  // BoardIterator class copy constructor
+  // this->board is set to other.board and this->elem is set to other.elem
+  //
+  // parameters
+  // ----------
+  // other : const BoardIterator &
+  //  - the BoardIterator class object from which to produce a copy
+  //
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K>::BasicBoardIterator(BasicBoardIterator<M,N,K> &&other) : BasicBoardIterator()
+{
+  //
+  // BoardIterator class move constructor
+  // other is moved into *this
+  //
+  // parameters
+  // ----------
+  // other : BoardIterator &&
+  //  - the BoardIterator class object to move from
+  //
+
+  swap(*this,other);
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K>::~BasicBoardIterator()
+{
+  //
+  // BoardIterator class destructor
+  //
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K> &BasicBoardIterator<M,N,K>::operator=(BasicBoardIterator<M,N,K> other)
+{
+  //
+  // BoardIterator operator=
+  // Assign a BoardIterator object to the BoardIterator in *this using copy-and-swap
+  //
+  // parameters
+  // ----------
+  // other : BoardIterator
+  //  - the BoardIterator object to assign from
+  //
+  // returns
+  // -------
+  // BoardIterator &
+  //  - the BoardIterator in other now in *this
+  //
+
+  swap(*this,other);
+  return *this;
+}
+
+template <int M, int N, int K>
+inline typename BasicBoardIterator<M,N,K>::reference BasicBoardIterator<M,N,K>::operator*() const
+{
+  //
+  // BoardIterator operator*
+  // Indirects to a const reference to this->elem
+  //
+  // returns
+  // -------
+  // BoardIterator::reference
+  //  - a reference to this->elem
+  //
+
+  return this->elem;
+}
+
+template <int M, int N, int K>
+inline typename BasicBoardIterator<M,N,K>::pointer BasicBoardIterator<M,N,K>::operator->() const
+{
+  //
+  // BoardIterator operator->
+  // Indirects to a pointer to this->elem
+  //
+  // returns
+  // -------
+  // BoardIterator::pointer
+  //  - a pointer to this->elem
+  //
+
+  return &this->elem;
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K> &BasicBoardIterator<M,N,K>::operator++()
+{
+  //
+  // BoardIterator operator++
+  // Increments and returns the iterator
+  //
+  // returns
+  // -------
+  // BoardIterator &
+  //  - a reference *this
+  // 
+
+  ++this->elem.pos;
+  ++this->elem.ind;
+  // the end of the board holds no value
+  this->elem.val=this->elem.ind<BasicBoard<M,N,K>::kPositions ? (*this->board)[this->elem.pos] : VALUE::kEmpty;
+  return *this;
+}
+
+template <int M, int N, int K>
+inline BasicBoardIterator<M,N,K> BasicBoardIterator<M,N,K>::operator++(int)
+{
+  //
+  // BoardIterator operator++(int)
+  // Increments the iterator and returns a copy of the pre-incremented iterator
+  //
+  // returns
+  // -------
+  // BasicBoardIterator<M,N,K>
+  //  - a copy of *this before incrementing
+  //
+
+  BasicBoardIterator res=*this;
+  ++*this;
+  return res;
+}
+
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K>::BasicBoard() : plays(ITERATION::kZero), crosses(0), noughts(0), cross_lines(), nought_lines()
+  , cross_threats(0), nought_threats(0), result(RESULT::kNotWon), hashes()
+{
+  //
+  // Board class constructor
+  // this->plays is set to ITERATION::kZero (0), this->crosses and this->noughts are both set to 0 so every position is
+  // VALUE::kEmpty (0), the line counts, threats, and hashes are zeroed, and this->result is set to RESULT::kNotWon (0)
+  //
+}
+
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K>::BasicBoard(const BasicBoard &other) : plays(other.plays), crosses(other.crosses), noughts(other.noughts)
+  , cross_lines(other.cross_lines), nought_lines(other.nought_lines), cross_threats(other.cross_threats)
+  , nought_threats(other.nought_threats), result(other.result), hashes(other.hashes)
+{
+  //
+  // Board class copy constructor
+  // this->plays, this->crosses, this->noughts, the line counts, the threats, this->result, and this->hashes are set to those of other
+  //
+  // parameters
+  // ----------
+  // other : const Board &
+  //  - the Board class object from which to produce a copy
+  //
+}
+
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K>::BasicBoard(BasicBoard &&other) : plays(other.plays), crosses(other.crosses), noughts(other.noughts)
+  , cross_lines(other.cross_lines), nought_lines(other.nought_lines), cross_threats(other.cross_threats)
+  , nought_threats(other.nought_threats), result(other.result), hashes(other.hashes)
+{
+  //
+  // Board class move constructor
+  // other is moved into *this, which, as Board owns no resources, copies it
+  //
+  // parameters
+  // ----------
+  // other : Board &&
+  //  - the Board class object to move from
+  //
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::clear_board(void)
+{
+  //
+  // Clear the board
+  // Sets all positions to VALUE::kEmpty (0)
+  //
+
+  this->crosses=0;
+  this->noughts=0;
+  this->cross_lines={};
+  this->nought_lines={};
+  this->cross_threats=0;
+  this->nought_threats=0;
+  this->result=RESULT::kNotWon;
+  this->hashes={};
+  this->plays=ITERATION::kZero;
+}
+
+template <int M, int N, int K>
+constexpr inline RESULT BasicBoard<M,N,K>::check_board(void) const
+{
+  //
+  // Check to see if the board contains a winning combination
+  // Considers if enough moves have been made, while the result itself is kept up to date by Board::assign_position, so no
+  // positions are considered
+  //
+  // returns
+  // -------
+  // RESULT
+  //  - if the board is a draw (RESULT::kDraw (3)), if it has not yet been won (RESULT::kNotWon (0)), if it has been won by cross
+  //    (RESULT::kCross (1)), or if it has been won by naught (RESULT::kNought (3))
+  //
+
+  if (this->plays<2*K-1) { return RESULT::kNotWon; } // no one can have won yet
+  return this->result;
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::count_lines(void)
+{
+  //
+  // Recount the positions each side holds in each of kWinningPositions, and so the threats and this->result, from this->crosses,
+  // this->noughts, and this->plays
+  // Used when positions are moved or set rather than assigned
+  //
+
+  this->result=RESULT::kNotWon;
+  for (size_t itr=0;itr<kWinningMasks.size();++itr)
+  {
+    this->cross_lines[itr]=static_cast<std::uint8_t>(popcount(this->crosses&kWinningMasks[itr]));
+    this->nought_lines[itr]=static_cast<std::uint8_t>(popcount(this->noughts&kWinningMasks[itr]));
+    this->update_threats(itr);
+    if (this->result==RESULT::kNotWon&&this->cross_lines[itr]==K) { this->result=RESULT::kCross; }
+    if (this->result==RESULT::kNotWon&&this->nought_lines[itr]==K) { this->result=RESULT::kNought; }
+  }
+  if (this->result==RESULT::kNotWon&&this->plays==kPositions) { this->result=RESULT::kDraw; }
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::update_threats(const size_t line) noexcept
+{
+  //
+  // Update whether each side threatens to complete a line, from the counts of the positions they hold in it
+  //
+  // parameters
+  // ----------
+  // line : const size_t
+  //  - the index of the line in kWinningPositions
+  //
+
+  const line_mask bit=static_cast<line_mask>(line_mask{1}<<line);
+  const bool cross_threat=this->cross_lines[line]==K-1&&this->nought_lines[line]==0
+    ,nought_threat=this->nought_lines[line]==K-1&&this->cross_lines[line]==0;
+  this->cross_threats=static_cast<line_mask>(cross_threat ? this->cross_threats|bit : this->cross_threats&~bit);
+  this->nought_threats=static_cast<line_mask>(nought_threat ? this->nought_threats|bit : this->nought_threats&~bit);
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::hash_positions(void)
+{
+  //
+  // Rehash the board from this->crosses and this->noughts
+  // Used when positions are moved or set rather than assigned
+  //
+
+  this->hashes={};
+  for (POSITION pos=POSITION::kTopLeft;pos<kPositions;++pos)
+  {
+    if (const VALUE val=this->get_value(pos);val!=VALUE::kEmpty) { this->toggle_hashes(pos,val); }
+  }
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline ITERATION BasicBoard<M,N,K>::get_plays(void) const
+{
+  //
+  // Board::plays getter
+  //
+  // returns
+  // -------
+  // ITERATION
+  //  - the number of moves made on the board
+  //
+
+  return this->plays;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::get_mask(const VALUE val) const
+{
+  //
+  // Board::crosses and Board::noughts getter
+  //
+  // parameters
+  // ----------
+  // val : const VALUE
+  //  - the value whose positions to get
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the positions holding val, where VALUE::kEmpty (0) gives the empty positions
+  //
+
+  if (val==VALUE::kCross) { return this->crosses; }
+  if (val==VALUE::kNought) { return this->noughts; }
+  return this->get_empty();
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline int BasicBoard<M,N,K>::rank(void) const
+{
+  //
+  // Rank the board among all 3^kPositions boards
+  // The rank is the board read as a base 3 number, with each position a digit of its VALUE and POSITION::kTopLeft (0) the least
+  // significant digit
+  //
+  // returns
+  // -------
+  // int
+  //  - the rank of the board, in [0,3^kPositions), which is [0,kRanks) for the 3x3 board
+  //
+
+  static_assert(kPositions<=19,"Only boards of at most 19 positions have ranks which fit in an int.");
+
+  int rank=0;
+  for (POSITION pos=static_cast<POSITION>(kPositions-1);pos>-1;pos=pos-1)
+  {
+    rank=rank*3+static_cast<int>(this->get_value(pos));
+  }
+  return rank;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline VALUE BasicBoard<M,N,K>::get_turn(void) const
+{
+  //
+  // Determine the side to move, where cross moves first
+  //
+  // returns
+  // -------
+  // VALUE
+  //  - VALUE::kCross (1) after an even number of moves, VALUE::kNought (2) after an odd number
+  //
+
+  return this->plays%2==0 ? VALUE::kCross : VALUE::kNought;
+}
+
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K> &BasicBoard<M,N,K>::operator>>=(const int n)
+{
+  //
+  // Board operator>>=
+  // Reflect the board along its vertical axis.
+  // This is isometry kIsometries/2, the first with a reflection
+  //
+  // parameters
+  // ----------
+  // n : const int
+  //  - number of reflections to make
+  //    if n%2==0, there is no reflection; if n%2==1, there is one reflection
+  //
+  // returns
+  // -------
+  // Board &
+  //  - reflected board
+  //
+
+  if (n%2==1) { this->isometry(kIsometries/2); }
+  return *this;
+}
+
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K> &BasicBoard<M,N,K>::operator<<=(int n)
+{
+  //
+  // Board operator<<=
+  // rotate the board n quater turns counterclockwise
+  // A board which is not square can only be turned by half turns, which are isometry 1 of its four
+  //
+  // parameters
+  // ----------
+  // n : int
+  //  - number of turns to make
+  //
+  // returns
+  // -------
+  // Board &
+  //  - rotated board
+  //
+  // throws
+  // ------
+  // std::invalid_argument
+  //  - if the board is not square and n is not a whole number of half turns
+  //
+
+  // actual number of turns to make
+  n%=4;
+  if constexpr (M==N) { if (n>0) { this->isometry(n); } }
+  else
+  {
+    if (n%2!=0) { throw std::invalid_argument("A board which is not square cannot be turned a quarter turn."); }
+    if (n!=0) { this->isometry(1); }
+  }
+
+  return *this;
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::isometry(const int isometry)
+{
+  //
+  // Move every position of the board by an isometry
+  //
+  // parameters
+  // ----------
+  // isometry : const int
+  //  - the isometry to apply, in [0,kIsometries)
+  //
+
+  this->crosses=apply_isometry(this->crosses,isometry);
+  this->noughts=apply_isometry(this->noughts,isometry);
+  this->count_lines();
+  this->hash_positions();
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::position_mask(const POSITION pos)
+{
+  //
+  // Create the mask of a single position
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to mask
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - a mask with only the bit of pos set
+  //
+
+  return static_cast<mask_type>(mask_type{1}<<static_cast<int>(pos));
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::apply_isometry(const mask_type mask
+  , const int isometry)
+{
+  //
+  // Move the positions of a mask by an isometry
+  //
+  // parameters
+  // ----------
+  // mask : const mask_type
+  //  - the mask to move
+  // isometry : const int
+  //  - the isometry to apply, in [0,kIsometries)
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the moved mask
+  //
+
+  // each row is moved by a single lookup
+  const std::array<std::array<mask_type,(1<<N)>,M> &rows=kIsometryRows[isometry];
+  mask_type moved=0;
+  for (int row=0;row<M;++row) { moved|=rows[row][mask>>(row*N)&((1<<N)-1)]; }
+  return moved;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] constexpr inline POSITION BasicBoard<M,N,K>::apply_isometry(const POSITION pos, const int isometry)
+{
+  //
+  // Move a position by an isometry
+  // A move on a board moved by an isometry is mapped back with the isometry in kInverseIsometries
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to move
+  // isometry : const int
+  //  - the isometry to apply, in [0,kIsometries)
+  //
+  // returns
+  // -------
+  // POSITION
+  //  - the moved position
+  //
+
+  return kIsometryPositions[isometry][static_cast<int>(pos)];
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::make_move_unchecked(const POSITION pos, const VALUE val) noexcept
+{
+  //
+  // Make a move without checking it is valid
+  // For searches, which only make moves on empty positions of unfinished boards; otherwise identical to Board::make_move
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position on the board, which must be in range and empty
+  // val : const VALUE
+  //  - the value of be set, which must not be VALUE::kEmpty (0)
+  //
+
+  (val==VALUE::kCross ? this->crosses : this->noughts)|=position_mask(pos);
+  ++this->plays;
+  this->toggle_hashes(pos,val);
+
+  // a line is won once one side holds all K of its positions
+  std::array<std::uint8_t,kLines> &lines=val==VALUE::kCross ? this->cross_lines : this->nought_lines;
+  const line_mask through=kPositionLines[static_cast<int>(pos)];
+  for (size_t itr=0;itr<lines.size();++itr)
+  {
+    if (!(through>>itr&1)) { continue; }
+    if (++lines[itr]==K) { this->result=static_cast<RESULT>(val); }
+    this->update_threats(itr);
+  }
+  // if all moves have been played, and no one has won, it is a draw
+  if (this->result==RESULT::kNotWon&&this->plays==kPositions) { this->result=RESULT::kDraw; }
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::unmake_move_unchecked(const POSITION pos, const VALUE val) noexcept
+{
+  //
+  // Undo a move without checking it was made
+  // For searches, which know the value they played; otherwise identical to Board::unmake_move
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position of the move to undo, which must be in range
+  // val : const VALUE
+  //  - the value held at pos, which must not be VALUE::kEmpty (0)
+  //
+
+  (val==VALUE::kCross ? this->crosses : this->noughts)&=static_cast<mask_type>(~position_mask(pos));
+  this->plays=this->plays-1;
+  this->toggle_hashes(pos,val);
+
+  std::array<std::uint8_t,kLines> &lines=val==VALUE::kCross ? this->cross_lines : this->nought_lines;
+  const line_mask through=kPositionLines[static_cast<int>(pos)];
+  for (size_t itr=0;itr<lines.size();++itr)
+  {
+    if (!(through>>itr&1)) { continue; }
+    --lines[itr];
+    this->update_threats(itr);
+  }
+  // the board was either unfinished before the move, or won by a line the move was not part of
+  if (this->result!=RESULT::kNotWon)
+  {
+    this->result=RESULT::kNotWon;
+    for (size_t itr=0;itr<lines.size();++itr)
+    {
+      if (this->cross_lines[itr]==K) { this->result=RESULT::kCross; }
+      else if (this->nought_lines[itr]==K) { this->result=RESULT::kNought; }
+    }
+  }
+}
+
+template <int M, int N, int K>
+constexpr inline void BasicBoard<M,N,K>::toggle_hashes(const POSITION pos, const VALUE val) noexcept
+{
+  //
+  // Add or remove a value at a position from the hash of every isometry
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position of the value
+  // val : const VALUE
+  //  - the value, either VALUE::kCross (1) or VALUE::kNought (2)
+  //
+
+  const std::array<std::uint64_t,kIsometries> &keys=kZobristKeys[static_cast<int>(val)-1][static_cast<int>(pos)];
+  for (int itr=0;itr<kIsometries;++itr) { this->hashes[itr]^=keys[itr]; }
+}
+
+template <int M, int N, int K>
+constexpr inline VALUE BasicBoard<M,N,K>::get_value(const POSITION pos) const noexcept
+{
+  //
+  // Get the value in the specified position without checking the position is in range
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position of the board, which must be in range
+  //
+  // returns
+  // -------
+  // VALUE
+  //  - the value of the board at pos
+  //
+
+  const int shift=static_cast<int>(pos);
+  return kPositionValues[(this->crosses>>shift&1)|(this->noughts>>shift&1)<<1];
+}
+
+template <int M, int N, int K>
+constexpr inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::get_empty(void) const
+{
+  //
+  // Get the empty positions of the board
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the positions held by neither side
+  //
+
+  return static_cast<mask_type>(~(this->crosses|this->noughts)&kFullBoard);
+}
+
+template <int M, int N, int K>
+inline MaskRange BasicBoard<M,N,K>::empty_positions(void) const
+{
+  //
+  // Get the empty positions of the board to iterate over
+  //
+  // returns
+  // -------
+  // MaskRange
+  //  - the empty positions, iterated lowest first
+  //
+
+  return MaskRange(this->get_empty());
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline int BasicBoard<M,N,K>::get_symmetries(void) const
+{
+  //
+  // Get the isometries which leave the board unchanged
+  // The hashes of the board under each isometry rule out all other isometries at once, and the masks confirm the rest
+  //
+  // returns
+  // -------
+  // int
+  //  - bit n is set if isometry n leaves the board unchanged; bit 0, the identity, is always set
+  //
+
+  int symmetries=1;
+  for (int itr=1;itr<kIsometries;++itr)
+  {
+    if (this->hashes[itr]!=this->hashes[0]) { continue; }
+    if (apply_isometry(this->crosses,itr)==this->crosses&&apply_isometry(this->noughts,itr)==this->noughts) { symmetries|=1<<itr; }
+  }
+  return symmetries;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::get_winning_moves(const VALUE val) const
+{
+  //
+  // Get the positions on which a side would win immediately
+  // Only the lines the side threatens are considered, of which there are few
+  //
+  // parameters
+  // ----------
+  // val : const VALUE
+  //  - the side to find the winning moves of, which must not be VALUE::kEmpty (0)
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the empty positions which complete a line of val
+  //
+
+  mask_type moves=0;
+  for (line_mask threats=val==VALUE::kCross ? this->cross_threats : this->nought_threats;threats;threats&=threats-1)
+  {
+    moves|=kWinningMasks[countr_zero(threats)];
+  }
+  return moves&this->get_empty();
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::get_blocking_moves(const VALUE val) const
+{
+  //
+  // Get the positions a side must play on to stop the other side winning on its next move
+  //
+  // parameters
+  // ----------
+  // val : const VALUE
+  //  - the side to find the blocking moves of, which must not be VALUE::kEmpty (0)
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the empty positions which complete a line of the other side; if more than one, the other side cannot be stopped
+  //
+
+  return this->get_winning_moves(opposite(val));
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline int BasicBoard<M,N,K>::get_line_score(const VALUE val) const
+{
+  //
+  // Score how close a side is to completing a line, against the other side
+  // Each line held by one side alone scores the square of the positions it holds, so lines nearer completion count for more
+  //
+  // parameters
+  // ----------
+  // val : const VALUE
+  //  - the side to score the board for, which must not be VALUE::kEmpty (0)
+  //
+  // returns
+  // -------
+  // int
+  //  - the score of the lines of val, less the score of the lines of the other side; 0 on an empty board
+  //
+
+  int score=0;
+  for (int itr=0;itr<kLines;++itr)
+  {
+    const int crosses=this->cross_lines[itr],noughts=this->nought_lines[itr];
+    if (noughts==0) { score+=crosses*crosses; }
+    if (crosses==0) { score-=noughts*noughts; }
+  }
+  return val==VALUE::kCross ? score : -score;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline typename BasicBoard<M,N,K>::mask_type BasicBoard<M,N,K>::get_distinct_empty(void) const
+{
+  //
+  // Get one empty position of each class of moves which give the same board up to an isometry
+  // Moves are in the same class if an isometry which leaves the board unchanged takes one to the other, so on the empty 3x3 board
+  // there are three: a corner, an edge, and the centre
+  //
+  // returns
+  // -------
+  // BasicBoard<M,N,K>::mask_type
+  //  - the lowest empty position of each class of moves
+  //
+
+  const int symmetries=this->get_symmetries();
+  const mask_type empty=this->get_empty();
+  // only the identity leaves most boards unchanged, and every move is distinct
+  if (symmetries==1) { return empty; }
+
+  mask_type distinct=0,seen=0;
+  for (POSITION pos:MaskRange(empty))
+  {
+    if (seen&position_mask(pos)) { continue; }
+    distinct|=position_mask(pos);
+    for (int itr=0;itr<kIsometries;++itr)
+    {
+      if (symmetries>>itr&1) { seen|=position_mask(apply_isometry(pos,itr)); }
+    }
+  }
+  return distinct;
+}
+
+template <int M, int N, int K>
+inline void BasicBoard<M,N,K>::assign_position(POSITION pos, const VALUE val)
+{
+  //
+  // Set a position on the board
+  // Sets the bit of the given position in the mask of the given value, increments this->plays, updates the counts of the
+  // winning combinations through the position, and so the result of the board, and updates the hashes
+  // For validating input; automated play should use Board::try_assign, and searches Board::make_move_unchecked
+  //
+  // parameters
+  // ----------
+  // pos : POSITION
+  //  - the position on the board
+  // val : const VALUE
+  //  - the value of be set
+  //
+  // throws
+  // ------
+  // assigning_empty_value
+  //  - if val is VALUE::kEmpty (0)
+  // std::out_of_range
+  //  - if pos is out of range
+  // non_empty_position
+  //  - if pos is already filled (i.e., does not equal VALUE::kEmpty (0))
+  // game_finished
+  //  - if the game has finished (by win or draw)
+  //
+
+  switch (this->try_assign(pos,val))
+  {
+  case (ASSIGNMENT::kAssigned): { return; }
+  case (ASSIGNMENT::kEmptyValue): { throw assigning_empty_value(); }
+  case (ASSIGNMENT::kOutOfRange): { throw std::out_of_range("Indexed position is out of range."); }
+  case (ASSIGNMENT::kNonEmptyPosition): { throw non_empty_position(pos,this->get_value(pos)); }
+  case (ASSIGNMENT::kGameFinished): { throw game_finished(this->check_board()); }
+  }
+}
+
+template <int M, int N, int K>
+inline ASSIGNMENT BasicBoard<M,N,K>::try_assign(const POSITION pos, const VALUE val) noexcept
+{
+  //
+  // Set a position on the board, if it is a valid move
+  // Performs the same checks as Board::assign_position, in the same order, but reports the first to fail rather than throwing
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position on the board
+  // val : const VALUE
+  //  - the value of be set
+  //
+  // returns
+  // -------
+  // ASSIGNMENT
+  //  - ASSIGNMENT::kAssigned (0) if the position was set, otherwise the reason it was not: ASSIGNMENT::kEmptyValue (1) if val is
+  //    VALUE::kEmpty (0), ASSIGNMENT::kOutOfRange (2) if pos is out of range, ASSIGNMENT::kNonEmptyPosition (3) if pos is already
+  //    filled, or ASSIGNMENT::kGameFinished (4) if the game has finished (by win or draw)
+  //
+
+  if (val==VALUE::kEmpty) { return ASSIGNMENT::kEmptyValue; }
+  if (!this->check_range(pos)) { return ASSIGNMENT::kOutOfRange; }
+  if (!(this->get_empty()&position_mask(pos))) { return ASSIGNMENT::kNonEmptyPosition; }
+  if (this->check_board()!=RESULT::kNotWon) { return ASSIGNMENT::kGameFinished; }
+
+  this->make_move_unchecked(pos,val);
+  return ASSIGNMENT::kAssigned;
+}
+
+template <int M, int N, int K>
+inline void BasicBoard<M,N,K>::make_move(const POSITION pos, const VALUE val)
+{
+  //
+  // Make a move which can be undone with Board::unmake_move
+  // Identical to Board::assign_position, so that moves can be made and unmade on a single board rather than copying it
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position on the board
+  // val : const VALUE
+  //  - the value of be set
+  //
+  // throws
+  // ------
+  // assigning_empty_value
+  //  - if val is VALUE::kEmpty (0)
+  // std::out_of_range
+  //  - if pos is out of range
+  // non_empty_position
+  //  - if pos is already filled (i.e., does not equal VALUE::kEmpty (0))
+  // game_finished
+  //  - if the game has finished (by win or draw)
+  //
+
+  this->assign_position(pos,val);
+}
+
+template <int M, int N, int K>
+inline void BasicBoard<M,N,K>::unmake_move(const POSITION pos)
+{
+  //
+  // Undo a move made with Board::make_move or Board::assign_position
+  // Empties the given position and restores this->plays, the line counts, this->result, and this->hashes to what they were before
+  // the move
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position of the move to undo
+  //
+  // throws
+  // ------
+  // unmaking_empty_position
+  //  - if pos is empty (i.e., equals VALUE::kEmpty (0))
+  // std::out_of_range
+  //  - if pos is out of range
+  //
+
+  const VALUE val=(*this)[pos];
+  if (val==VALUE::kEmpty) { throw unmaking_empty_position(pos); }
+
+  this->unmake_move_unchecked(pos,val);
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline BasicBoardIterator<M,N,K> BasicBoard<M,N,K>::begin(void) const
+{
+  //
+  // Create an iterator to the beginning of the board
+  //
+  // returns
+  // -------
+  // BoardIterator
+  //  - an iterator at the beginning of the board
+  //
+
+  return BasicBoardIterator<M,N,K>(this,0);
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline BasicBoardIterator<M,N,K> BasicBoard<M,N,K>::end(void) const
+{
+  //
+  // Create an iterator to the end of the board
+  //
+  // returns
+  // -------
+  // BoardIterator
+  //  - an iterator at the end of the board
+  //
+
+  return BasicBoardIterator<M,N,K>(this,kPositions);
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline CanonicalKey BasicBoard<M,N,K>::canonical_key(void) const
+{
+  //
+  // Identify the board's class of isometries
+  // Each isometry of the masks is encoded as crosses|noughts<<kPositions, and the smallest encoding is the key
+  //
+  // returns
+  // -------
+  // CanonicalKey
+  //  - the key, identical for all boards which match under an isometry, and the isometry which produced it
+  //    a position on the board is moved to the canonical board with apply_isometry(pos,isometry), and back with
+  //    apply_isometry(pos,kInverseIsometries[isometry])
+  //
+
+  static_assert(2*kPositions<=64,"Only boards of at most 32 positions have keys which fit in 64 bits.");
+
+  CanonicalKey canonical={std::numeric_limits<std::uint64_t>::max(),0};
+  for (int itr=0;itr<kIsometries;++itr)
+  {
+    const std::uint64_t key=apply_isometry(this->crosses,itr)|static_cast<std::uint64_t>(apply_isometry(this->noughts,itr))<<kPositions;
+    if (key<canonical.key) { canonical={key,itr}; }
+  }
+  return canonical;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline std::uint64_t BasicBoard<M,N,K>::hash(void) const
+{
+  //
+  // Get the Zobrist hash of the board
+  // The side to move is not part of the hash, as it is given by the number of plays
+  //
+  // returns
+  // -------
+  // std::uint64_t
+  //  - the hash of the board
+  //
+
+  return this->hashes[0];
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline std::uint64_t BasicBoard<M,N,K>::symmetric_hash(void) const
+{
+  //
+  // Get the Zobrist hash of the board's class of isometries
+  //
+  // returns
+  // -------
+  // std::uint64_t
+  //  - the smallest hash of the board over all isometries, identical for all boards which match under an isometry
+  //
+
+  return *std::min_element(std::cbegin(this->hashes),std::cend(this->hashes));
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline int BasicBoard<M,N,K>::symmetric_isometry(void) const
+{
+  //
+  // Get the isometry under which the board's hash is the hash of its class of isometries
+  // Unlike canonical_key, this is defined on boards of any size
+  //
+  // returns
+  // -------
+  // int
+  //  - the isometry whose hash is symmetric_hash(); a position is moved to the board of that hash with apply_isometry(pos,isometry),
+  //    and back with apply_isometry(pos,kInverseIsometries[isometry])
+  //
+
+  return static_cast<int>(std::distance(std::cbegin(this->hashes),std::min_element(std::cbegin(this->hashes),std::cend(this->hashes))));
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline int BasicBoard<M,N,K>::legal_index(void) const
+{
+  //
+  // Index the board among the kLegalPositions boards which can be reached in a game
+  // Legal boards are indexed in order of their rank
+  //
+  // returns
+  // -------
+  // int
+  //  - the legal index of the board, in [0,kLegalPositions), or -1 if the board cannot be reached in a game
+  //
+
+  static_assert(std::is_same<BasicBoard,Board>::value,"Only the 3x3 board has its legal positions indexed.");
+  return LegalPositions::get().indices[this->rank()];
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline int BasicBoard<M,N,K>::class_index(void) const
+{
+  //
+  // Index the board's class of isometries among the kIsometryClasses classes of boards which can be reached in a game
+  // Classes are indexed in order of the rank of their smallest board
+  //
+  // returns
+  // -------
+  // int
+  //  - the class index of the board, in [0,kIsometryClasses), identical for all boards which match under an isometry, or -1 if the 
+  //    board cannot be reached in a game
+  //
+
+  static_assert(std::is_same<BasicBoard,Board>::value,"Only the 3x3 board has its legal positions indexed.");
+  return LegalPositions::get().classes[this->rank()];
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline bool BasicBoard<M,N,K>::is_legal(void) const
+{
+  //
+  // Check if the board can be reached in a game, where cross plays first
+  // Cross must have played as many or one more positions than nought, at most one side can have won, and no moves can have been
+  // made after the winning move
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if the board can be reached in a game, false otherwise
+  //
+
+  const int cross_count=popcount(this->crosses),nought_count=popcount(this->noughts);
+  if (cross_count!=nought_count&&cross_count!=nought_count+1) { return false; }
+
+  const bool cross_won=std::find(std::cbegin(this->cross_lines),std::cend(this->cross_lines),K)!=std::cend(this->cross_lines)
+    ,nought_won=std::find(std::cbegin(this->nought_lines),std::cend(this->nought_lines),K)!=std::cend(this->nought_lines);
+  if (cross_won&&nought_won) { return false; }
+  // the winner made the last move
+  if (cross_won&&cross_count!=nought_count+1) { return false; }
+  if (nought_won&&cross_count!=nought_count) { return false; }
+  return true;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] inline BasicBoard<M,N,K> BasicBoard<M,N,K>::from_rank(const int rank)
 {
-public:
-  VALUE val;
-  POSITION pos;
-  size_t ind;
+  //
+  // Create the board of a given rank
+  // The inverse of Board::rank. The board need not be reachable in a game
+  //
+  // parameters
+  // ----------
+  // rank : const int
+  //  - the rank of the board
+  //
+  // returns
+  // -------
+  // Board
+  //  - the board with the given rank
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if rank is not in [0,3^kPositions), which is [0,kRanks) for the 3x3 board
+  //
 
-  BoardElement();
-  BoardElement(const VALUE val, const POSITION pos, const size_t ind);
-  ~BoardElement();
+  static_assert(kPositions<=19,"Only boards of at most 19 positions have ranks which fit in an int.");
 
-private:
-  bool check_range(const size_t idx);
-};
+  int ranks=1;
+  for (int itr=0;itr<kPositions;++itr) { ranks*=3; }
+  if (rank<0||rank>=ranks) { throw std::out_of_range("Rank is out of range."); }
+
+  BasicBoard board;
+  int digits=rank;
+  for (POSITION pos=POSITION::kTopLeft;pos<kPositions;++pos,digits/=3)
+  {
+    // positions are set directly, as assigning them could find a win before all are placed
+    const VALUE val=static_cast<VALUE>(digits%3);
+    if (val==VALUE::kEmpty) { continue; }
+    (val==VALUE::kCross ? board.crosses : board.noughts)|=position_mask(pos);
+    ++board.plays;
+  }
+  board.count_lines();
+  board.hash_positions();
+  return board;
+}
 
-class BoardIterator
+template <int M, int N, int K>
+[[nodiscard]] inline BasicBoard<M,N,K> BasicBoard<M,N,K>::from_legal_index(const int index)
 {
-  using const_board_iterator=std::array<VALUE,9>::const_iterator;
+  //
+  // Create the board of a given legal index
+  // The inverse of Board::legal_index
+  //
+  // parameters
+  // ----------
+  // index : const int
+  //  - the legal index of the board
+  //
+  // returns
+  // -------
+  // Board
+  //  - the board with the given legal index
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if index is not in [0,kLegalPositions)
+  //
 
-  const_board_iterator board_itr;
-  BoardElement elem;
+  static_assert(std::is_same<BasicBoard,Board>::value,"Only the 3x3 board has its legal positions indexed.");
 
-public:
-  using pointer=const BoardElement * const;
-  using reference=const BoardElement &;
+  if (index<0||index>=kLegalPositions) { throw std::out_of_range("Legal index is out of range."); }
+  return BasicBoard::from_rank(LegalPositions::get().ranks[index]);
+}
 
-  using iterator_category=std::array<VALUE,9>::const_iterator::iterator_category;
-  using difference_type=std::array<VALUE,9>::const_iterator::difference_type;
-  using value_type=std::array<VALUE,9>::const_iterator::value_type;
+template <int M, int N, int K>
+[[nodiscard]] inline BasicBoard<M,N,K> BasicBoard<M,N,K>::from_class_index(const int index)
+{
+  //
+  // Create the smallest board, by rank, of a given class index
+  // The inverse of Board::class_index up to an isometry
+  //
+  // parameters
+  // ----------
+  // index : const int
+  //  - the class index of the board
+  //
+  // returns
+  // -------
+  // Board
+  //  - the board of smallest rank with the given class index
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if index is not in [0,kIsometryClasses)
+  //
 
-  BoardIterator::BoardIterator();
-  BoardIterator(const const_board_iterator begin, const const_board_iterator board_itr);
-  BoardIterator(const BoardIterator &other);
-  BoardIterator(BoardIterator &&other);
-  ~BoardIterator();
+  static_assert(std::is_same<BasicBoard,Board>::value,"Only the 3x3 board has its legal positions indexed.");
 
-  // assignment
-  BoardIterator &operator=(BoardIterator other);
-  // dereference
-  reference operator*() const;
-  pointer operator->() const;
-  // increment
-  BoardIterator &operator++();
-  BoardIterator operator++(int);
-  // comparison
-  friend inline bool operator==(const BoardIterator &lhs, const BoardIterator &rhs);
-  friend inline bool operator!=(const BoardIterator &lhs, const BoardIterator &rhs);
-  // swap
-  friend void swap(BoardIterator &first, BoardIterator &second) noexcept;
-};
+  if (index<0||index>=kIsometryClasses) { throw std::out_of_range("Class index is out of range."); }
+  return BasicBoard::from_rank(LegalPositions::get().class_ranks[index]);
+}
 
-class Board
+template <int M, int N, int K>
+[[nodiscard]] inline const VALUE &BasicBoard<M,N,K>::at(const POSITION &pos)
 {
-public:
-  Board();
-  Board(const Board &other);
-  Board(Board &&other);
-  ~Board();
+  //
+  // Board value getter
+  // Get a const reference to the value in the specified position
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION &
+  //  - the position of the board
+  //
+  // returns
+  // -------
+  // const VALUE &
+  //  - the value of the board at pos
+  //
 
-  void assign_position(POSITION pos, const VALUE value);
-  void clear_board(void);
-  RESULT check_board(void) const;
+  return (*this)[pos];
+}
 
-  // iterators
-  [[nodiscard]] BoardIterator begin(void) const;
-  [[nodiscard]] BoardIterator end(void) const;
+template <int M, int N, int K>
+[[nodiscard]] inline const VALUE &BasicBoard<M,N,K>::at(const POSITION &pos) const
+{
+  //
+  // Board value getter
+  // Get a const reference to the value in the specified position
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION &
+  //  - the position of the board
+  //
+  // returns
+  // -------
+  // const VALUE &
+  //  - the value of the board at pos
+  //
 
-  // getters
-  [[nodiscard]] ITERATION get_plays(void) const;
-  [[nodiscard]] const VALUE &at(const POSITION &pos);
-  [[nodiscard]] const VALUE &at(const POSITION &pos) const;
-  [[nodiscard]] const VALUE &operator[](const POSITION &pos);
-  [[nodiscard]] const VALUE &operator[](const POSITION &pos) const;
+  return (*this)[pos];
+}
 
-  // assignment
-  Board &operator=(Board other);
-  Board &operator>>=(const int n);
-  Board &operator<<=(int n);
-  // comparison
-  friend inline bool operator==(const Board &lhs, const Board &rhs);
-  // isometries
-  friend inline Board operator>>(Board lhs, const int n);
-  friend inline Board operator<<(Board lhs, const int n);
-  // io
-  friend std::ostream &operator<<(std::ostream &os, const Board &board); // defined in ui.cpp to make use of coloured text
-  // swap
-  friend void swap(Board &first, Board &second) noexcept;
+template <int M, int N, int K>
+[[nodiscard]] inline const VALUE &BasicBoard<M,N,K>::operator[](const POSITION &pos)
+{
+  //
+  // Board operator[]
+  // Get a const reference to the value in the specified position
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION &
+  //  - the position of the board
+  //
+  // returns
+  // -------
+  // const VALUE &
+  //  - the value of the board at pos
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if pos is out of range
+  //
 
-private:
-  ITERATION plays;
-  std::array<VALUE,9> board;
-  int cross_count,nought_count;
+  return static_cast<const BasicBoard &>(*this)[pos];
+}
 
-  bool check_equal(const std::array<POSITION, 3> &pos) const;
-  bool check_range(const POSITION pos) const;
+template <int M, int N, int K>
+[[nodiscard]] inline const VALUE &BasicBoard<M,N,K>::operator[](const POSITION &pos) const
+{
+  //
+  // Board operator[]
+  // Get a const reference to the value in the specified position
+  // The reference is to the matching element of kPositionValues, as the board itself only holds masks
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION &
+  //  - the position of the board
+  //
+  // returns
+  // -------
+  // const VALUE &
+  //  - the value of the board at pos
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if pos is out of range
+  //
+
+  if (!this->check_range(pos)) { throw std::out_of_range("Indexed position is out of range."); }
+
+  const int shift=static_cast<int>(pos);
+  return kPositionValues[(this->crosses>>shift&1)|(this->noughts>>shift&1)<<1];
+}
+
+template <int M, int N, int K>
+inline bool BasicBoard<M,N,K>::check_range(const POSITION pos) const
+{
+  //
+  // Check if a given position is in range for the board
+  // The position is out of range if its integral value is strictly less than 0 or not strictly less than kPositions
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to check against
+  //
+  // returns
+  // -------
+  // bool
+  //  - false if the position is out of range, true otherwise
+  //
+
+  if (pos<0||pos>kPositions-1) { return false; }
+  return true;
+}
+
+template <int M, int N, int K>
+inline BasicBoard<M,N,K> &BasicBoard<M,N,K>::operator=(BasicBoard<M,N,K> other)
+{
+  //
+  // Board operator=
+  // Assign a Board object to the Board in *this using copy-and-swap
+  //
+  // parameters
+  // ----------
+  // other : Board
+  //  - the Board object to assign from
+  //
+  // returns
+  // -------
+  // Board &
+  //  - the Board in other now in *this
+  //
+
+  swap(*this,other);
+  return *this;
+}
 
-  // getters
-  [[nodiscard]] VALUE &at(POSITION &pos);
-  [[nodiscard]] VALUE &operator[](POSITION &pos);
-};
 
 // Inline Overloads
-inline bool operator==(const BoardIterator &lhs, const BoardIterator &rhs)
+inline bool operator==(const MaskIterator &lhs, const MaskIterator &rhs)
+{
+  //
+  // MaskIterator operator==
+  // Compare two instances of MaskIterator
+  //
+  // parameters
+  // ----------
+  // lhs,rhs : const MaskIterator &
+  //  - the port and starboard sides of the equality
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if they have the same positions left to iterate over, false otherwise
+  //
+
+  return lhs.mask==rhs.mask;
+}
+
+inline bool operator!=(const MaskIterator &lhs, const MaskIterator &rhs)
+{
+  //
+  // MaskIterator operator!=
+  // Compare two instances of MaskIterator
+  //
+  // parameters
+  // ----------
+  // lhs,rhs : const MaskIterator &
+  //  - the port and starboard sides of the inequality
+  //
+  // returns
+  // -------
+  // bool
+  //  - false if they have the same positions left to iterate over, true otherwise
+  //
+
+  return !(lhs==rhs);
+}
+
+template <int M, int N, int K>
+inline bool operator==(const BasicBoardIterator<M,N,K> &lhs, const BasicBoardIterator<M,N,K> &rhs)
 {
   //
   // BoardIterator operator==
@@ -170,13 +2122,14 @@ inline bool operator==(const BoardIterator &lhs, const BoardIterator &rhs)
   // returns
   // -------
   // bool
-  //  - true if their iterator is the same, false otherwise
+  //  - true if they iterate over the same board and are at the same position, false otherwise
   //
 
-  return lhs.board_itr==rhs.board_itr;
+  return lhs.board==rhs.board&&lhs.elem.ind==rhs.elem.ind;
 }
 
-inline bool operator!=(const BoardIterator &lhs, const BoardIterator &rhs)
+template <int M, int N, int K>
+inline bool operator!=(const BasicBoardIterator<M,N,K> &lhs, const BasicBoardIterator<M,N,K> &rhs)
 {
   //
   // BoardIterator operator!=
@@ -196,7 +2149,8 @@ inline bool operator!=(const BoardIterator &lhs, const BoardIterator &rhs)
   return !(lhs==rhs);
 }
 
-inline bool operator==(const Board &lhs, const Board &rhs)
+template <int M, int N, int K>
+inline bool operator==(const BasicBoard<M,N,K> &lhs, const BasicBoard<M,N,K> &rhs)
 {
   //
   // Board operator==
@@ -210,28 +2164,20 @@ inline bool operator==(const Board &lhs, const Board &rhs)
   // returns
   // -------
   // bool
-  //  - true if any isometries of lhs::board and rhs::board match, false otherwise
+  //  - true if any isometries of lhs and rhs match, false otherwise
   //
 
-  // if they don't have the same number of each, they can never be equal
-  if (!(lhs.cross_count==rhs.cross_count&&lhs.nought_count==rhs.nought_count)) { return false; }
-  
-  // check all permutations
-  for (int itr=0;itr<2;++itr)
+  const typename BasicBoard<M,N,K>::mask_type crosses=rhs.get_mask(VALUE::kCross),noughts=rhs.get_mask(VALUE::kNought);
+  for (int itr=0;itr<BasicBoard<M,N,K>::kIsometries;++itr)
   {
-    Board tmp=lhs;
-    tmp>>=itr; // flip
-    for (int jtr=0;jtr<4;jtr++)
-    {
-      tmp<<=1; // rotate
-      // only one isometry has to match
-      if (tmp.board==rhs.board) { return true; }
-    }
+    if (BasicBoard<M,N,K>::apply_isometry(lhs.get_mask(VALUE::kCross),itr)==crosses
+      &&BasicBoard<M,N,K>::apply_isometry(lhs.get_mask(VALUE::kNought),itr)==noughts) { return true; }
   }
   return false;
 }
 
-inline Board operator<<(Board lhs, const int n)
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K> operator<<(BasicBoard<M,N,K> lhs, const int n)
 {
   //
   // Board operator<<
@@ -254,7 +2200,8 @@ inline Board operator<<(Board lhs, const int n)
   return lhs;
 }
 
-inline Board operator>>(Board lhs, const int n)
+template <int M, int N, int K>
+constexpr inline BasicBoard<M,N,K> operator>>(BasicBoard<M,N,K> lhs, const int n)
 {
   //
   // Board operator>>
@@ -277,6 +2224,165 @@ inline Board operator>>(Board lhs, const int n)
   lhs>>=n;
   return lhs;
 }
+
+template <int M, int N, int K>
+inline void swap(BasicBoardIterator<M,N,K> &first, BasicBoardIterator<M,N,K> &second) noexcept
+{
+  //
+  // Swap two BoardIterator objects
+  // Swaps BoardIterator::board and BoardIterator::elem of the two objects
+  //
+  // parameters
+  // ----------
+  // first,second : BoardIterator&
+  //  - the BoardIterator objects to swap
+  //
+
+  std::swap(first.board,second.board);
+  std::swap(first.elem,second.elem);
+}
+
+template <int M, int N, int K>
+inline void swap(BasicBoard<M,N,K> &first, BasicBoard<M,N,K> &second) noexcept
+{
+  //
+  // Swap two Board objects
+  // Swaps Board::plays, Board::crosses, Board::noughts, the line counts, the threats, Board::result, and Board::hashes
+  //
+  // parameters
+  // ----------
+  // first,second : Board&
+  //  - the Board objects to swap
+  //
+
+  std::swap(first.plays,second.plays);
+  std::swap(first.crosses,second.crosses);
+  std::swap(first.noughts,second.noughts);
+  std::swap(first.cross_lines,second.cross_lines);
+  std::swap(first.nought_lines,second.nought_lines);
+  std::swap(first.cross_threats,second.cross_threats);
+  std::swap(first.nought_threats,second.nought_threats);
+  std::swap(first.result,second.result);
+  std::swap(first.hashes,second.hashes);
+}
+
+constexpr inline board_mask apply_isometry(const board_mask mask, const int isometry)
+{
+  //
+  // Move the positions of a mask of the 3x3 board by an isometry
+  //
+  // parameters
+  // ----------
+  // mask : const board_mask
+  //  - the mask to move
+  // isometry : const int
+  //  - the isometry to apply, in [0,kIsometries)
+  //
+  // returns
+  // -------
+  // board_mask
+  //  - the moved mask
+  //
+
+  return Board::apply_isometry(mask,isometry);
+}
+
+constexpr inline POSITION apply_isometry(const POSITION pos, const int isometry)
+{
+  //
+  // Move a position of the 3x3 board by an isometry
+  // A move on a board moved by an isometry is mapped back with the isometry in kInverseIsometries
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to move
+  // isometry : const int
+  //  - the isometry to apply, in [0,kIsometries)
+  //
+  // returns
+  // -------
+  // POSITION
+  //  - the moved position
+  //
+
+  return Board::apply_isometry(pos,isometry);
+}
+
+// Solver
+constexpr inline int solve_position(Board &board, const int rank, std::array<SolvedPosition,kRanks> &solved)
+{
+  //
+  // Determine the value and optimal moves of a board, and of every board reachable from it
+  // Equivalent to minimax over the full game tree, with each rank solved once however many ways it is reached
+  // Children are made and unmade on board itself, which is returned unchanged
+  //
+  // parameters
+  // ----------
+  // board : Board &
+  //  - the Board to solve
+  // rank : const int
+  //  - the rank of board, passed down rather than recalculated for each child
+  // solved : std::array<SolvedPosition,kRanks> &
+  //  - the positions solved so far, indexed by rank, which is filled in for board and its descendants
+  //
+  // returns
+  // -------
+  // int
+  //  - the value of board to the side to move
+  //
+
+  if (solved[rank].value!=SolvedPosition::kUnsolved) { return solved[rank].value; }
+
+  SolvedPosition position={0,0};
+  const RESULT result=board.check_board();
+  // the side which moved last has won, or no one can
+  if (result!=RESULT::kNotWon) { position.value=result==RESULT::kDraw ? 0 : -1; }
+  else
+  {
+    const VALUE turn=board.get_turn();
+    const board_mask empty=board.get_empty();
+    int best=-1;
+    // the rank of a child is the rank of board plus the digit of the move
+    for (int pos=0,digit=1;pos<9;++pos,digit*=3)
+    {
+      if (!(empty>>pos&1)) { continue; }
+      board.make_move_unchecked(static_cast<POSITION>(pos),turn);
+      const int value=-solve_position(board,rank+static_cast<int>(turn)*digit,solved);
+      board.unmake_move_unchecked(static_cast<POSITION>(pos),turn);
+
+      if (value>best) { best=value; position.moves=0; }
+      if (value==best) { position.moves|=position_mask(static_cast<POSITION>(pos)); }
+    }
+    position.value=static_cast<std::int8_t>(best);
+  }
+
+  solved[rank]=position;
+  return position.value;
+}
+
+constexpr inline std::array<SolvedPosition,kRanks> make_solved_positions(void)
+{
+  //
+  // Solve every board which can be reached in a game
+  //
+  // returns
+  // -------
+  // std::array<SolvedPosition,kRanks>
+  //  - the solution of each board, indexed by rank, with SolvedPosition::kUnsolved for boards which cannot be reached
+  //
+
+  std::array<SolvedPosition,kRanks> solved={};
+  for (SolvedPosition &position:solved) { position={SolvedPosition::kUnsolved,0}; }
+  Board board;
+  solve_position(board,0,solved);
+  return solved;
+}
+
+[[nodiscard]] const std::array<SolvedPosition,kRanks> &solved_positions(void);
+
+// io
+std::ostream &operator<<(std::ostream &os, const Board &board); // defined in ui.cpp to make use of coloured text
 } // namespace menace
 
 #endif // BOARD_H__
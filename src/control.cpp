@@ -113,6 +113,9 @@ void Control::run(void)
         ,automaton_second_game=find(kAutomatonSecondGames,game->type)!=-1
         ,meance_first_game=find(kMENACEFirstGames,game->type)!=-1,menace_second_game=find(kMENACESecondGames,game->type)!=-1;
       bool exit_game=false;
+      // the last advice given, and the board it was given on
+      std::vector<MoveEvaluation> advice;
+      Board advised_board;
 
       // play game
       while (board.check_board()==RESULT::kNotWon)
@@ -132,6 +135,9 @@ void Control::run(void)
         // get a move from the player
         else
         {
+          // the automaton, if any, thinks over its reply while the player chooses their move
+          Automaton *opponent=game->get_plays()%2==0 ? automaton_two : automaton_one;
+          if (opponent) { opponent->ponder(); }
           try
           {
             pos=ui.get_move(game->get_plays());
@@ -155,16 +161,14 @@ void Control::run(void)
             {
             case (REQUEST::kAdvise):
             {
-              // get a move from MENACE
+              // get the value of every move from MENACE, kept in case it is asked to move on the same board
               Board advise_board=this->board;
-              ui.display_board=&advise_board;
               MENACE advise_menace=MENACE(game->players[static_cast<int>(game->get_plays()%2)]->value,advise_board);
-              POSITION advise_pos=advise_menace.get_move();
-              // make the move on the temporary board
-              advise_board.assign_position(advise_pos,advise_menace.value);
+              advice=advise_menace.evaluate_moves();
+              advised_board=this->board;
 
-              // mark that position as adivisial
-              ui.set_advisial(advise_pos);
+              // mark the moves as adivisial
+              ui.set_advisial(advice,advise_menace.value);
 
               ui.clear(77); // clear beneath the user input
               ui.move(0,0,origin); // move back to origin
@@ -172,17 +176,22 @@ void Control::run(void)
               ui.clear(30,7,77,origin); // clear user input
               ui.move(0,7,origin); // move to user input location
 
-              // reset boards back
-              ui.display_board=&board;
               ui.reset_advisial();
               continue; // play loop
             }
             case (REQUEST::kMove):
             {
-              // get a move from MENACE
+              // get a move from MENACE, from its advice if it has advised on the board
               Board move_board(*ui.display_board);
               MENACE move_menace=MENACE(game->players[static_cast<int>(game->get_plays()%2)]->value,move_board);
-              POSITION move_pos=move_menace.get_move();
+              // the advice is of the moves of the board as it lay, so a board only equal to it up to an isometry is advised on afresh
+              if (advice.empty()||advised_board.get_mask(VALUE::kCross)!=move_board.get_mask(VALUE::kCross)
+                ||advised_board.get_mask(VALUE::kNought)!=move_board.get_mask(VALUE::kNought))
+              {
+                advice=move_menace.evaluate_moves();
+                advised_board=move_board;
+              }
+              POSITION move_pos=MENACE::choose_move(advice);
               // make the move
               game->play(move_pos);
 
@@ -198,22 +207,26 @@ void Control::run(void)
         if (exit_game) { break; }
 
         // second: play move
-        try
-        {
-          game->play(pos);
-        }
-        catch(const non_empty_position &err)
+        const ASSIGNMENT assignment=game->try_play(pos);
+        if (assignment==ASSIGNMENT::kNonEmptyPosition)
         {
           ui.clear(77); // clear beneath the user input
           ui.move(0,8,origin); // move to error location
-          ui.print_error(ERR::kInvalidPosition,{kPositionStrings.at(err.pos),kValueStrings.at(err.val)});
+          ui.print_error(ERR::kInvalidPosition,{kPositionStrings.at(pos),kValueStrings.at(board.get_value(pos))});
           ui.clear(30,7,77,origin); // clear user input
           ui.move(0,7,origin); // move to user input location
           continue; // play loop
         }
-        catch(const game_finished &)
+        if (assignment==ASSIGNMENT::kGameFinished) { break; }
+        // a position off the board, or a player with no value, cannot come from the game, but the move was not made
+        if (assignment!=ASSIGNMENT::kAssigned)
         {
-          break;
+          ui.clear(77); // clear beneath the user input
+          ui.move(0,8,origin); // move to error location
+          ui.print_error(ERR::kError);
+          ui.clear(30,7,77,origin); // clear user input
+          ui.move(0,7,origin); // move to user input location
+          continue; // play loop
         }
 
         // third: reset for next move
@@ -226,6 +239,8 @@ void Control::run(void)
       if (exit_game)
       {
         // reset for the next game
+        if (automaton_one) { automaton_one->stop_pondering(); }
+        if (automaton_two) { automaton_two->stop_pondering(); }
         automaton_one=nullptr;
         automaton_two=nullptr;
         board.clear_board();
@@ -252,6 +267,8 @@ void Control::run(void)
       }
 
       // reset for the next game
+      if (automaton_one) { automaton_one->stop_pondering(); }
+      if (automaton_two) { automaton_two->stop_pondering(); }
       automaton_one=nullptr;
       automaton_two=nullptr;
       board.clear_board();
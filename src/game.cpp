@@ -14,7 +14,8 @@
 
 namespace menace
 {
-Game::Game(Board &board, Player *player_one, Player *player_two, const GAME type) : board(board), players({player_one,player_two})
+template <int M, int N, int K>
+BasicGame<M,N,K>::BasicGame(BasicBoard<M,N,K> &board, BasicPlayer<M,N,K> *player_one, BasicPlayer<M,N,K> *player_two, const GAME type) : board(board), players({player_one,player_two})
   , type(type)
 {
   //
@@ -23,9 +24,9 @@ Game::Game(Board &board, Player *player_one, Player *player_two, const GAME type
   //
   // parameters
   // ----------
-  // board : Board &
+  // board : BasicBoard<M,N,K> &
   //  - the Board the game will be played on
-  // player_one,player_two : Player *
+  // player_one,player_two : BasicPlayer<M,N,K> *
   //  - the two players to play the game
   // type : const GAME
   //  - the type of game, encoding if the players are people, random, or MENACEs
@@ -51,14 +52,16 @@ Game::Game(Board &board, Player *player_one, Player *player_two, const GAME type
   { throw invalid_game_player_combination(player_one->value,player_two->value,type); }
 }
 
-Game::~Game()
+template <int M, int N, int K>
+BasicGame<M,N,K>::~BasicGame()
 {
   //
   // Game class destructor
   //
 }
 
-void Game::play(const POSITION pos)
+template <int M, int N, int K>
+void BasicGame<M,N,K>::play(const POSITION pos)
 {
   //
   // Make a move on the board
@@ -73,7 +76,29 @@ void Game::play(const POSITION pos)
   this->players[static_cast<int>(this->get_plays()%2)]->make_move(pos);
 }
 
-[[nodiscard]] ITERATION Game::get_plays(void) const
+template <int M, int N, int K>
+ASSIGNMENT BasicGame<M,N,K>::try_play(const POSITION pos) noexcept
+{
+  //
+  // Make a move on the board, if it is a valid move
+  // Determines whose move it is based on the number of plays, and makes that player move on the given position
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the POSITION to move on
+  //
+  // returns
+  // -------
+  // ASSIGNMENT
+  //  - ASSIGNMENT::kAssigned (0) if the move was made, otherwise the reason it was not, as given by Board::try_assign
+  //
+
+  return this->players[static_cast<int>(this->get_plays()%2)]->try_make_move(pos);
+}
+
+template <int M, int N, int K>
+[[nodiscard]] ITERATION BasicGame<M,N,K>::get_plays(void) const
 {
   //
   // Game::board::plays getter
@@ -86,4 +111,10 @@ void Game::play(const POSITION pos)
 
   return this->board.get_plays();
 }
+
+// the boards games are built for
+template class BasicGame<3,3,3>;
+template class BasicGame<4,4,3>;
+template class BasicGame<5,5,4>;
+template class BasicGame<7,7,5>;
 } // namespace menace
@@ -40,21 +40,26 @@ public:
 };
 
 // Classes
-class Game
+template <int M, int N, int K>
+class BasicGame
 {
 public:
-  Game(Board &board, Player *player_one, Player *player_two, const GAME type);
-  ~Game();
+  BasicGame(BasicBoard<M,N,K> &board, BasicPlayer<M,N,K> *player_one, BasicPlayer<M,N,K> *player_two, const GAME type);
+  ~BasicGame();
 
   void play(const POSITION pos);
+  ASSIGNMENT try_play(const POSITION pos) noexcept;
 
   [[nodiscard]] ITERATION get_plays(void) const;
 
   const GAME type;
-  const std::array<const Player * const,2> players;
+  const std::array<const BasicPlayer<M,N,K> * const,2> players;
 private:
-  Board &board;
+  BasicBoard<M,N,K> &board;
 };
+
+// the game of noughts and crosses
+using Game=BasicGame<3,3,3>;
 } // namespace menace
 
 #endif // GAME_H__
@@ -17,16 +17,39 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <exception>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <set>
+#include <type_traits>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+
 namespace menace
 {
 // Enums
+enum class ASSIGNMENT
+{
+  kAssigned=0
+  , kEmptyValue
+  , kOutOfRange
+  , kNonEmptyPosition
+  , kGameFinished
+};
+
+enum class BOUND : std::uint8_t
+{
+  kExact=0
+  , kLower
+  , kUpper
+};
+
 enum class COLOUR
 {
   kRed=0
@@ -37,6 +60,14 @@ enum class COLOUR
   , kCyan
 };
 
+enum class DRIVER
+{
+  kAlphaBeta=0
+  , kPrincipalVariation
+  , kAspiration
+  , kMTDf
+};
+
 enum class GAME
 {
   kPvP=0
@@ -50,6 +81,13 @@ enum class GAME
   , kPvR
 };
 
+enum class INDEXING
+{
+  kRank=0
+  , kLegal
+  , kClass
+};
+
 enum class ITERATION
 {
   kZero=0
@@ -98,6 +136,21 @@ enum class REQUEST
   , kMove
 };
 
+enum class SEARCH
+{
+  kSerial=0
+  , kRoot
+  , kYoungBrothers
+  , kLazySMP
+};
+
+enum class STOP
+{
+  kNone=0
+  , kReturn
+  , kAbort
+};
+
 enum class VALUE
 {
   kEmpty=0
@@ -204,6 +257,31 @@ inline std::vector<T> operator+(const std::vector<T> &lhs, const std::vector<T>
   std::copy(std::cbegin(rhs),std::cend(rhs),std::back_inserter(out));
   return out;
 }
+// the value of the other side
+constexpr inline VALUE opposite(const VALUE value)
+{
+  return value==VALUE::kCross ? VALUE::kNought : VALUE::kCross;
+}
+// number of set bits in a mask
+template <typename T>
+constexpr inline int popcount(T mask)
+{
+  int count=0;
+  for (;mask;mask&=mask-1) { ++count; }
+  return count;
+}
+// index of the lowest set bit in a non-zero mask
+template <typename T>
+inline int countr_zero(const T mask)
+{
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanForward64(&idx,static_cast<unsigned long long>(mask));
+  return static_cast<int>(idx);
+#else
+  return __builtin_ctzll(static_cast<unsigned long long>(mask));
+#endif // _MSC_VER
+}
 // finding an element
 template <typename Container, typename T>
 inline int find(const Container &container, const T val)
@@ -10,11 +10,15 @@
 
 
 #include <player.hpp>
+#include <atomic>
 #include <iostream>
+#include <optional>
+#include <thread>
 
 namespace menace
 {
-Player::Player(const VALUE value, Board &board) : value(value), board(board)
+template <int M, int N, int K>
+BasicPlayer<M,N,K>::BasicPlayer(const VALUE value, BasicBoard<M,N,K> &board) : value(value), board(board)
 {
   //
   // Player class constructor
@@ -24,7 +28,7 @@ Player::Player(const VALUE value, Board &board) : value(value), board(board)
   // ----------
   // value : const VALUE
   //  - the value for the Player to play
-  // board : Board &
+  // board : BasicBoard<M,N,K> &
   //  - the board for the Player to play on
   //
   // throws
@@ -36,7 +40,8 @@ Player::Player(const VALUE value, Board &board) : value(value), board(board)
   if (value==VALUE::kEmpty) { throw assigning_empty_player(); }
 }
 
-void Player::make_move(POSITION pos) const
+template <int M, int N, int K>
+void BasicPlayer<M,N,K>::make_move(POSITION pos) const
 {
   //
   // Make a move at a given position
@@ -50,12 +55,34 @@ void Player::make_move(POSITION pos) const
   this->board.assign_position(pos,this->value);
 }
 
-[[nodiscard]] PLAYER Player::ident(void) const
+template <int M, int N, int K>
+ASSIGNMENT BasicPlayer<M,N,K>::try_make_move(const POSITION pos) const noexcept
+{
+  //
+  // Make a move at a given position, if it is a valid move
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the position to play on
+  //
+  // returns
+  // -------
+  // ASSIGNMENT
+  //  - ASSIGNMENT::kAssigned (0) if the move was made, otherwise the reason it was not, as given by Board::try_assign
+  //
+
+  return this->board.try_assign(pos,this->value);
+}
+
+template <int M, int N, int K>
+[[nodiscard]] PLAYER BasicPlayer<M,N,K>::ident(void) const
 {
   return PLAYER::kPlayer;
 }
 
-Automaton::Automaton(const VALUE value, Board &board) : Player(value,board)
+template <int M, int N, int K>
+BasicAutomaton<M,N,K>::BasicAutomaton(const VALUE value, BasicBoard<M,N,K> &board) : BasicPlayer<M,N,K>(value,board)
 {
   //
   // Automaton class constructor
@@ -64,12 +91,31 @@ Automaton::Automaton(const VALUE value, Board &board) : Player(value,board)
   // ----------
   // value : const VALUE
   //  - the value for the Automaton to play
-  // board : Board &
+  // board : BasicBoard<M,N,K> &
   //  - the board for the Automaton to play on
   //
 }
 
-bool Automaton::valid_move(const Board &state, POSITION pos) const
+template <int M, int N, int K>
+void BasicAutomaton<M,N,K>::ponder(void)
+{
+  //
+  // Think over the next move on the opponent's time, while they choose their move
+  // An Automaton which does not search has nothing to think over
+  //
+}
+
+template <int M, int N, int K>
+void BasicAutomaton<M,N,K>::stop_pondering(void)
+{
+  //
+  // Stop thinking over the next move on the opponent's time, as when the game ends before they move
+  // An Automaton which does not search has nothing to stop
+  //
+}
+
+template <int M, int N, int K>
+bool BasicAutomaton<M,N,K>::valid_move(const BasicBoard<M,N,K> &state, POSITION pos) const
 {
   //
   // Determine if making a move is valid on a given board
@@ -77,7 +123,7 @@ bool Automaton::valid_move(const Board &state, POSITION pos) const
   //
   // parameters
   // ----------
-  // state : const Board &
+  // state : const BasicBoard<M,N,K> &
   //  - the Board to check against
   // pos : POSITION 
   //  - the position of the move
@@ -86,7 +132,8 @@ bool Automaton::valid_move(const Board &state, POSITION pos) const
   return state[pos]==VALUE::kEmpty;
 }
 
-bool Automaton::valid_move(const POSITION pos) const
+template <int M, int N, int K>
+bool BasicAutomaton<M,N,K>::valid_move(const POSITION pos) const
 {
   //
   // Determine if making a move is valid on Player::board
@@ -101,94 +148,270 @@ bool Automaton::valid_move(const POSITION pos) const
   return this->board[pos]==VALUE::kEmpty;
 }
 
-std::vector<POSITION> Automaton::determine_possible_moves(const Board &state) const
+template <int M, int N, int K>
+MoveList<BasicBoard<M,N,K>::kPositions> BasicAutomaton<M,N,K>::determine_possible_moves(const BasicBoard<M,N,K> &state) const
 {
   //
   // Determine all possible moves that can be made on a given board
   //
   // parameters
   // ----------
-  // state : const Board &
+  // state : const BasicBoard<M,N,K> &
   //  - the Board to check against
   //
   // returns
   // -------
-  // std::vector<POSITION>
+  // MoveList<BasicBoard<M,N,K>::kPositions>
   //  - all positions where a move can be made on state
   //
 
-  std::vector<POSITION> possible;
-  for (const BoardElement &itr:state)
-  {
-    if (itr.val==VALUE::kEmpty) { possible.push_back(itr.pos); }
-  }
-
-  return possible;
+  return MoveList<BasicBoard<M,N,K>::kPositions>(state.get_empty());
 }
 
-std::vector<POSITION> Automaton::determine_possible_moves(void) const
+template <int M, int N, int K>
+MoveList<BasicBoard<M,N,K>::kPositions> BasicAutomaton<M,N,K>::determine_possible_moves(void) const
 {
   //
   // Determine all possible moves that can be made on Player::board
   //
   // returns
   // -------
-  // std::vector<POSITION>
+  // MoveList<BasicBoard<M,N,K>::kPositions>
   //  - all positions where a move can be made on Player::board
   //
 
   return this->determine_possible_moves(this->board);
 }
 
-MENACE::MENACE(const VALUE value, Board &board) : Automaton(value,board)
+template <int M, int N, int K>
+BasicMENACE<M,N,K>::BasicMENACE(const VALUE value, BasicBoard<M,N,K> &board, const size_t table_bytes)
+  : BasicAutomaton<M,N,K>(value,board), evaluations(table_bytes), driver(DRIVER::kAlphaBeta), search(SEARCH::kSerial), workers(1), pool()
+  , time_limit(0)
+  , node_limit(0), deadline(std::chrono::steady_clock::time_point()), spent(0), expired(false), pondering(false), depth(0), stop()
+  , ponderer(), expected(), pondered(board), pondered_values()
 {
   //
   // MENACE class constructor
+  // this->evaluations starts empty, and keeps the boards evaluated by every search for later moves and later games
+  // MENACE searches on the calling thread alone until told otherwise by BasicMENACE::set_search, and searches to the end of the game
+  // until told otherwise by BasicMENACE::set_limits, searching each move with plain alpha-beta until told otherwise by
+  // BasicMENACE::set_driver
   //
   // parameters
   // ----------
   // value : const VALUE
   //  - the value for MENACE to play
-  // board : Board &
+  // board : BasicBoard<M,N,K> &
   //  - the board for MENACE to play on
+  // table_bytes : const size_t
+  //  - the memory this->evaluations may use, defaults to TranspositionTable::kDefaultBytes
+  //
+}
+
+template <int M, int N, int K>
+BasicMENACE<M,N,K>::~BasicMENACE()
+{
+  //
+  // MENACE class destructor
+  // A search on the opponent's time uses the members of *this, so must be stopped before they go
   //
+
+  this->stop_pondering();
 }
 
-POSITION MENACE::get_move(void)
+template <int M, int N, int K>
+POSITION BasicMENACE<M,N,K>::get_move(void)
 {
   //
   // Get a move from MENACE
-  // Uses minimax to determine the value of all possible moves and randomly chooses one of the moves which returns the best value
+  // On the 3x3 board, looks up the optimal moves of the board in the table of solved positions and randomly chooses one of them
+  // Boards which are not in the table, or on which it is not MENACE's turn, and boards of any other size, are searched instead,
+  // answered from the search MENACE pondered if the opponent made the move it expected
   //
   // returns
   // -------
   // POSITION
   //  - the position for MENACE to make
   //
+  // throws
+  // ------
+  // search_aborted
+  //  - if the search was asked to stop with STOP::kAbort
+  //
 
-  std::array<int,9> values;
-  // -1 is the worst MENACE can be gauranteed, so fill with minimum integer so there is a way to distinguish invalid moves and valid moves 
-  // with value -1
-  std::fill(std::begin(values),std::end(values),std::numeric_limits<int>::min());
+  if constexpr (kSolved)
+  {
+    const SolvedPosition &solved=solved_positions()[this->board.rank()];
+    // boards which cannot be reached in a game, or which are finished, have no moves in the table
+    if (solved.moves!=0&&this->board.get_turn()==this->value)
+    {
+      this->stop_pondering();
+      MoveList<BasicBoard<M,N,K>::kPositions> out(solved.moves);
+      // randomise and return
+      std::shuffle(std::begin(out),std::end(out),std::mt19937_64{std::random_device{}()});
+      return out.front();
+    }
+  }
+  return this->search_move();
+}
 
-  std::vector<POSITION> possible=this->determine_possible_moves();
+template <int M, int N, int K>
+std::vector<MoveEvaluation> BasicMENACE<M,N,K>::evaluate_moves(const bool variations)
+{
+  //
+  // Determine the value of every move MENACE can make, from kWin for a win to -kWin for a loss, and optionally the moves expected to
+  // follow each of them
+  // On the 3x3 board, the values and variations come from the table of solved positions, under the same conditions as
+  // BasicMENACE::get_move; otherwise the board is searched, with the limits and search set for MENACE, with every move valued exactly
+  // A search stopped before any iteration completes leaves out the moves it did not search
+  //
+  // parameters
+  // ----------
+  // variations : const bool
+  //  - if the principal variation of each move is to be found, defaults to false
+  //
+  // returns
+  // -------
+  // std::vector<MoveEvaluation>
+  //  - the evaluation of each move, best first, which can be given to BasicMENACE::choose_move for the move to make
+  //
+  // throws
+  // ------
+  // search_aborted
+  //  - if the search was asked to stop with STOP::kAbort
+  //
 
-  // consider all possible positions
-  for (POSITION pos:possible)
+  // a search on the opponent's time values only the best moves exactly
+  this->stop_pondering();
+  std::vector<MoveEvaluation> evaluation;
+  if constexpr (kSolved)
+  {
+    const std::array<SolvedPosition,kRanks> &solved=solved_positions();
+    if (solved[this->board.rank()].moves!=0&&this->board.get_turn()==this->value)
+    {
+      BasicBoard<M,N,K> state=this->board;
+      for (const POSITION pos:MoveList<kPositions>(state.get_empty()))
+      {
+        state.make_move_unchecked(pos,this->value);
+        // the value of the child is to the other side
+        MoveEvaluation move={pos,-solved[state.rank()].value*kWin,{}};
+        if (variations)
+        {
+          // follow the first optimal move of each board to the end of the game, completing a line where one can be, as the table
+          // values a win later the same as a win now
+          BasicBoard<M,N,K> line=state;
+          move.variation.push_back(pos);
+          for (VALUE val=opposite(this->value);solved[line.rank()].moves!=0;val=opposite(val))
+          {
+            const typename BasicBoard<M,N,K>::mask_type wins=line.get_winning_moves(val);
+            const POSITION next=MoveList<kPositions>(wins ? wins : solved[line.rank()].moves).front();
+            line.make_move_unchecked(next,val);
+            move.variation.push_back(next);
+          }
+        }
+        state.unmake_move_unchecked(pos,this->value);
+        evaluation.push_back(move);
+      }
+    }
+  }
+  if (evaluation.empty())
+  {
+    const std::array<int,kPositions> values=this->search_values(this->board,true);
+    for (const POSITION pos:MoveList<kPositions>(this->board.get_empty()))
+    {
+      if (values[static_cast<int>(pos)]==std::numeric_limits<int>::min()) { continue; }
+      evaluation.push_back({pos,values[static_cast<int>(pos)],variations ? this->principal_variation(pos) : std::vector<POSITION>()});
+    }
+  }
+  std::stable_sort(std::begin(evaluation),std::end(evaluation),[](const MoveEvaluation &lhs, const MoveEvaluation &rhs)
+    { return lhs.value>rhs.value; });
+  return evaluation;
+}
+
+template <int M, int N, int K>
+POSITION BasicMENACE<M,N,K>::choose_move(const std::vector<MoveEvaluation> &evaluation)
+{
+  //
+  // Randomly choose one of the best moves of an evaluation, so one search can both advise and move
+  //
+  // parameters
+  // ----------
+  // evaluation : const std::vector<MoveEvaluation> &
+  //  - the evaluation of the moves of a board, as given by BasicMENACE::evaluate_moves
+  //
+  // returns
+  // -------
+  // POSITION
+  //  - the position for MENACE to make
+  //
+  // throws
+  // ------
+  // std::invalid_argument
+  //  - if the evaluation has no moves
+  //
+
+  if (evaluation.empty()) { throw std::invalid_argument("An evaluation must have a move to choose."); }
+  const int max=std::max_element(std::cbegin(evaluation),std::cend(evaluation),[](const MoveEvaluation &lhs, const MoveEvaluation &rhs)
+    { return lhs.value<rhs.value; })->value;
+  // push the positions which enable the maximum into out
+  MoveList<kPositions> out;
+  for (const MoveEvaluation &move:evaluation)
   {
-    // create the child
-    Board child=this->board;
-    child.assign_position(pos,this->value);
-    // determine its value, the MENACE in *this is the maximising player
-    int val=this->minimax(child,-1,1,false,this->value,this->value==VALUE::kCross ? VALUE::kNought : VALUE::kCross);
-    values[static_cast<int>(pos)]=val;
+    if (move.value==max) { out.push_back(move.pos); }
   }
+  // randomise and return
+  std::shuffle(std::begin(out),std::end(out),std::mt19937_64{std::random_device{}()});
+  return out.front();
+}
+
+template <int M, int N, int K>
+POSITION BasicMENACE<M,N,K>::search_move(void)
+{
+  //
+  // Get a move from MENACE by search
+  // Randomly chooses one of the moves with the best value, as found by BasicMENACE::search_values, or the first move to be searched
+  // if the search was stopped before any move was searched
+  // If MENACE pondered the board in play, the search on the opponent's time is kept, now with the limits of a search of MENACE's
+  // own, and its values used; otherwise it is aborted, and the board is searched afresh
+  //
+  // returns
+  // -------
+  // POSITION
+  //  - the position for MENACE to make
+  //
+  // throws
+  // ------
+  // search_aborted
+  //  - if the search was asked to stop with STOP::kAbort
+  //
 
+  std::array<int,BasicBoard<M,N,K>::kPositions> values;
+  // the values are of the moves of the board pondered as it lies, so a move symmetric to the one expected, whose board is only equal
+  // to it up to an isometry, is not the move expected
+  if (this->ponderer.joinable()&&this->board.get_mask(VALUE::kCross)==this->pondered.get_mask(VALUE::kCross)
+    &&this->board.get_mask(VALUE::kNought)==this->pondered.get_mask(VALUE::kNought))
+  {
+    // the limits of the search run from the opponent's move
+    this->spent=0;
+    this->deadline=std::chrono::steady_clock::now()+this->time_limit;
+    this->pondering=false;
+    this->ponderer.join();
+    this->expected.reset();
+    // the search on the opponent's time may have been aborted by a request of the caller's
+    values=this->pondered_values ? *this->pondered_values : this->search_values(this->board,false);
+  }
+  else
+  {
+    this->stop_pondering();
+    values=this->search_values(this->board,false);
+  }
   // find the maximum value
-  const std::array<int,9>::const_iterator max=std::max_element(std::cbegin(values),std::cend(values));
+  const typename std::array<int,BasicBoard<M,N,K>::kPositions>::const_iterator max=std::max_element(std::cbegin(values),std::cend(values));
+  // no move was searched before the search was stopped
+  if (*max==std::numeric_limits<int>::min()) { return MoveList<BasicBoard<M,N,K>::kPositions>(this->board.get_distinct_empty()).front(); }
   // push the positions which enable the maximum into out
-  std::vector<POSITION> out;
-  for (std::array<int,9>::const_iterator itr=std::cbegin(values),end=std::cend(values);itr!=end;++itr)
+  MoveList<BasicBoard<M,N,K>::kPositions> out;
+  for (typename std::array<int,BasicBoard<M,N,K>::kPositions>::const_iterator itr=std::cbegin(values),end=std::cend(values);itr!=end;++itr)
   {
     if (*itr==*max) { out.push_back(static_cast<POSITION>(std::distance(std::cbegin(values),itr))); }
   }
@@ -197,96 +420,1035 @@ POSITION MENACE::get_move(void)
   return out.front();
 }
 
-int MENACE::minimax(const Board &state, int alpha, int beta, const bool maximising_player, const VALUE maximiser_value
-  , const VALUE minimiser_value)
+template <int M, int N, int K>
+std::array<int,BasicMENACE<M,N,K>::kPositions> BasicMENACE<M,N,K>::search_values(const BasicBoard<M,N,K> &root, const bool exact)
+{
+  //
+  // Determine the value of each of MENACE's moves of a board by search
+  // Uses negamax to determine the value of all possible moves; unless they are to be exact, moves worse than the best need only be
+  // shown to be worse, and their values are only bounds
+  // If the search is limited, the board is searched one move deeper at a time, each iteration ordering the moves by the last, and the
+  // values of the last iteration to complete are used; otherwise the board is searched to the end of the game at once
+  // A search stopped through this->stop before it completes an iteration uses the values of the moves it has searched; the request is
+  // withdrawn once the search has stopped
+  //
+  // parameters
+  // ----------
+  // root : const BasicBoard<M,N,K> &
+  //  - the board to search, the board in play unless MENACE is pondering
+  // exact : const bool
+  //  - if the value of every move is needed, rather than only which moves are best
+  //
+  // returns
+  // -------
+  // std::array<int,BasicBoard<M,N,K>::kPositions>
+  //  - the value of each move, or the minimum integer for positions which are not moves or were not searched
+  //
+  // throws
+  // ------
+  // search_aborted
+  //  - if the search was asked to stop with STOP::kAbort
+  //
+
+  std::array<int,BasicBoard<M,N,K>::kPositions> values;
+  // -kWin is the worst MENACE can be gauranteed, so fill with minimum integer so there is a way to distinguish invalid moves and valid 
+  // moves with value -kWin
+  std::fill(std::begin(values),std::end(values),std::numeric_limits<int>::min());
+
+  // moves which give the same board up to an isometry have the same value, so only one of each is searched
+  MoveList<BasicBoard<M,N,K>::kPositions> possible(root.get_distinct_empty());
+  const int symmetries=root.get_symmetries();
+  // entries of earlier searches are kept, but are replaced before those of this search
+  this->evaluations.new_search();
+  // the move ordering of one search says little of another
+  for (Worker &worker:this->workers) { worker.clear(); }
+  // the limits of the search run from here, unless it is on the opponent's time, when they run from the opponent's move
+  if (!this->pondering)
+  {
+    this->deadline=std::chrono::steady_clock::now()+this->time_limit;
+    this->spent=0;
+  }
+  this->expired=false;
+  this->depth=0;
+
+  const int empties=popcount(root.get_empty());
+  for (int depth=this->limited() ? 1 : empties;depth<=empties;++depth)
+  {
+    std::array<int,BasicBoard<M,N,K>::kPositions> current;
+    std::fill(std::begin(current),std::end(current),std::numeric_limits<int>::min());
+    // each iteration is guided by the values of the last
+    this->search_root(root,possible,symmetries,depth,values,exact,current);
+    // the values of an iteration cut short are not all known; the first iteration visits too few boards to be cut short by the
+    // limits, but not too few to be stopped, when what is known of it is better than nothing
+    if (this->expired)
+    {
+      if (this->depth==0) { values=current; }
+      break;
+    }
+    values=current;
+    this->depth=depth;
+    // the best moves of one iteration are searched first in the next, so the rest are cut off sooner
+    std::stable_sort(std::begin(possible),std::end(possible),[&values](const POSITION lhs, const POSITION rhs)
+      { return values[static_cast<int>(lhs)]>values[static_cast<int>(rhs)]; });
+    // a win, or a loss whichever move is made, is not changed by searching deeper, but the value of every move must be settled for
+    // the values to be exact
+    const int max=values[static_cast<int>(possible.front())];
+    if (exact ? std::all_of(std::cbegin(possible),std::cend(possible),[&values](const POSITION pos)
+      { return std::abs(values[static_cast<int>(pos)])==kWin; }) : max==kWin||max==-kWin) { break; }
+  }
+
+  // the request has been answered
+  const STOP stopped=this->stop.requested();
+  this->stop.reset();
+  if (stopped==STOP::kAbort) { throw search_aborted(); }
+  return values;
+
+}
+
+template <int M, int N, int K>
+std::vector<POSITION> BasicMENACE<M,N,K>::principal_variation(const POSITION pos)
+{
+  //
+  // Find the moves expected to follow a move of the board in play, from the best moves kept in this->evaluations by the last search
+  // The variation goes no deeper than the last iteration the search completed, but for a line completed at its end, and ends early
+  // where the table has no move
+  //
+  // parameters
+  // ----------
+  // pos : const POSITION
+  //  - the move of MENACE's which starts the variation
+  //
+  // returns
+  // -------
+  // std::vector<POSITION>
+  //  - pos, then the best move of each side in turn
+  //
+
+  std::vector<POSITION> variation={pos};
+  BasicBoard<M,N,K> state=this->board;
+  state.make_move_unchecked(pos,this->value);
+  for (VALUE val=opposite(this->value);state.check_board()==RESULT::kNotWon;val=opposite(val))
+  {
+    POSITION next;
+    // a line which can be completed is, though negamax keeps no move for the board, and however deep the search went
+    if (const typename BasicBoard<M,N,K>::mask_type wins=state.get_winning_moves(val);wins)
+    {
+      next=MoveList<kPositions>(wins).front();
+    }
+    else
+    {
+      if (static_cast<int>(variation.size())>=this->depth) { break; }
+      const int move=this->table_move(state,val);
+      if (move==kNoMove) { break; }
+      next=static_cast<POSITION>(move);
+    }
+    state.make_move_unchecked(next,val);
+    variation.push_back(next);
+  }
+  return variation;
+}
+
+template <int M, int N, int K>
+int BasicMENACE<M,N,K>::table_move(const BasicBoard<M,N,K> &state, const VALUE player_val)
+{
+  //
+  // Look up the best move of a board in this->evaluations
+  //
+  // parameters
+  // ----------
+  // state : const BasicBoard<M,N,K> &
+  //  - the board to look up
+  // player_val : const VALUE
+  //  - the side to move on state
+  //
+  // returns
+  // -------
+  // int
+  //  - the best move kept for state, in the orientation of state, or kNoMove if none is kept
+  //
+
+  const std::uint64_t key=state.symmetric_hash()^(player_val==VALUE::kNought ? kNoughtToMove : 0);
+  int alpha=-kWin,beta=kWin,value,move;
+  static_cast<void>(this->evaluations.probe(key,0,alpha,beta,value,move));
+  if (move==kNoMove) { return kNoMove; }
+  // the move is kept for the board of the class whose hash is the key
+  const POSITION pos=BasicBoard<M,N,K>::apply_isometry(static_cast<POSITION>(move)
+    ,BasicBoard<M,N,K>::kInverseIsometries[state.symmetric_isometry()]);
+  // another board with the same key
+  return state[pos]==VALUE::kEmpty ? static_cast<int>(pos) : kNoMove;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::ponder(void)
+{
+  //
+  // Search on the opponent's time, while they choose their move
+  // The move expected of the opponent is the best kept for the board in this->evaluations, or the first move they would search if
+  // none is kept, and the board after it is searched on another thread, with no limits until BasicMENACE::get_move is called
+  // Nothing is pondered if the board is finished, if it is MENACE's turn, if MENACE is already pondering, or if the board after the
+  // expected move is in the table of solved positions
+  // Setting how MENACE searches, clearing its table, and evaluating its moves abort the search first; BasicMENACE::get_nodes and
+  // BasicMENACE::get_depth are not to be called until it is over
+  //
+
+  if (this->ponderer.joinable()||this->board.check_board()!=RESULT::kNotWon||this->board.get_turn()==this->value) { return; }
+
+  const VALUE other=opposite(this->value);
+  const int move=this->table_move(this->board,other);
+  const POSITION guess=move!=kNoMove ? static_cast<POSITION>(move)
+    : MoveList<kPositions>(this->board.get_distinct_empty()).front();
+  this->pondered=this->board;
+  this->pondered.make_move_unchecked(guess,other);
+  if (this->pondered.check_board()!=RESULT::kNotWon) { return; }
+  if constexpr (kSolved)
+  {
+    if (solved_positions()[this->pondered.rank()].moves!=0) { return; }
+  }
+
+  this->expected=guess;
+  this->pondering=true;
+  this->pondered_values.reset();
+  this->ponderer=std::thread([this]()
+  {
+    try
+    {
+      this->pondered_values=this->search_values(this->pondered,false);
+    }
+    catch (const search_aborted &) {}
+  });
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::stop_pondering(void)
+{
+  //
+  // Abort the search on the opponent's time, if there is one, and wait for it to stop
+  // A request made of this->stop during the search is withdrawn with it
+  //
+
+  if (!this->ponderer.joinable()) { return; }
+  this->stop.request(STOP::kAbort);
+  this->ponderer.join();
+  // the search may have finished before it was asked to stop, leaving the request for the next
+  this->stop.reset();
+  this->pondering=false;
+  this->expected.reset();
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::search_root(const BasicBoard<M,N,K> &root, const MoveList<kPositions> &possible, const int symmetries
+  , const int depth, const std::array<int,kPositions> &guesses, const bool exact, std::array<int,kPositions> &values)
+{
+  //
+  // Determine the value of each of MENACE's moves of a board, searching a given number of moves ahead
+  // With SEARCH::kRoot, the moves are shared between the threads of this->pool as each thread finishes its last
+  // With SEARCH::kYoungBrothers, the calling thread searches the moves, and the other threads take the children it splits off
+  // With SEARCH::kLazySMP, the other threads search the same moves in other orders, half of them one move deeper, sharing what they
+  // find only through this->evaluations, until the calling thread is done
+  //
+  // parameters
+  // ----------
+  // root : const BasicBoard<M,N,K> &
+  //  - the board to search, left unchanged
+  // possible : const MoveList<kPositions> &
+  //  - the distinct moves of the board, in the order to search them
+  // symmetries : const int
+  //  - the isometries which leave the board unchanged, as given by BasicBoard::get_symmetries
+  // depth : const int
+  //  - the number of moves to search ahead, including the move searched
+  // guesses : const std::array<int,kPositions> &
+  //  - the value of each move in the last iteration, or the minimum integer if there was none
+  // exact : const bool
+  //  - if the value of every move is needed, rather than only which moves are best
+  // values : std::array<int,kPositions> &
+  //  - set to the value of each move, and of each move symmetric to it
+  //
+
+  // the next move to search, and the best value found so far by any thread
+  std::atomic<size_t> next(0);
+  std::atomic<int> best(-kWin);
+  const std::function<void(const int)> job=[this,&root,&possible,symmetries,depth,&guesses,exact,&values,&next,&best](const int thread)
+  {
+    // search on a copy so the board searched is never modified
+    BasicBoard<M,N,K> state=root;
+    for (size_t itr;(itr=next++)<possible.size();)
+    {
+      const POSITION pos=possible[itr];
+      // moves worse than the best so far need only be shown to be worse, but moves as good must be valued exactly to be chosen
+      // among, so the window is opened one below the best, but no lower than a loss so a win still cuts off
+      const int floor=exact ? -kWin : std::max(best.load()-1,-kWin);
+      // move to the child
+      state.make_move_unchecked(pos,this->value);
+      // determine its value, the MENACE in *this is the maximising player, and its opponent is to move
+      const int val=this->search_child(this->workers[thread],state,floor,guesses[static_cast<int>(pos)],depth-1);
+      state.unmake_move_unchecked(pos,this->value);
+      // the value is not known if the search was cut short
+      if (this->expired) { break; }
+      // the value is shared by every move of the class, so all of them can be chosen
+      for (int iso=0;iso<BasicBoard<M,N,K>::kIsometries;++iso)
+      {
+        if (symmetries>>iso&1) { values[static_cast<int>(BasicBoard<M,N,K>::apply_isometry(pos,iso))]=val; }
+      }
+      for (int current=best.load();val>current&&!best.compare_exchange_weak(current,val);) {}
+    }
+  };
+  // consider all possible positions
+  if (!this->pool) { job(0); }
+  else if (this->search==SEARCH::kRoot) { this->pool->run(job); }
+  else if (this->search==SEARCH::kLazySMP)
+  {
+    // a split point cut off once the calling thread is done, so the searches of the other threads are cancelled with it
+    SplitPoint stop(root,nullptr,this->value,0,depth,-kWin,kWin,-kWin,kNoMove,0);
+    this->pool->run([this,&root,&job,&possible,depth,&stop](const int thread)
+    {
+      if (thread==0)
+      {
+        job(thread);
+        stop.cutoff=true;
+        return;
+      }
+      Worker &worker=this->workers[thread];
+      worker.split=&stop;
+      BasicBoard<M,N,K> state=root;
+      // each thread starts from a different move, and its values are only of use through the table
+      for (size_t itr=0;itr<possible.size()&&!stop.cancelled();++itr)
+      {
+        const POSITION pos=possible[(itr+thread)%possible.size()];
+        state.make_move_unchecked(pos,this->value);
+        this->negamax<false>(worker,state,-kWin,kWin,1,depth-1+thread%2);
+        state.unmake_move_unchecked(pos,this->value);
+      }
+      worker.split=nullptr;
+    });
+  }
+  else
+  {
+    std::atomic<bool> done(false);
+    this->pool->run([this,&job,&done](const int thread)
+    {
+      if (thread==0)
+      {
+        job(thread);
+        done=true;
+        return;
+      }
+      // the other threads search what is split off until the moves are done
+      while (!done)
+      {
+        if (!this->steal(this->workers[thread])) { std::this_thread::yield(); }
+      }
+    });
+  }
+}
+
+template <int M, int N, int K>
+int BasicMENACE<M,N,K>::search_child(Worker &worker, BasicBoard<M,N,K> &child, const int floor, const int guess, const int depth)
+{
+  //
+  // Determine the value to MENACE of the board a move of MENACE's leads to, as exactly as it is needed
+  // A move valued at or below floor is worse than the best found so far, so only needs to be shown to be
+  // How the windows of the search are chosen is set by this->driver:
+  //  - DRIVER::kAlphaBeta searches once with the window above floor
+  //  - DRIVER::kPrincipalVariation asks if the move beats floor with a null window, and searches again for the value if it does
+  //  - DRIVER::kAspiration searches within kAspirationWindow of guess, and again beyond whichever side the value fell outside of
+  //  - DRIVER::kMTDf closes on the value with null windows from guess, each settled largely by the transposition table
+  //
+  // parameters
+  // ----------
+  // worker : Worker &
+  //  - the thread searching
+  // child : BasicBoard<M,N,K> &
+  //  - the board after MENACE's move, with its opponent to move
+  // floor : const int
+  //  - the value at or below which the move is not needed exactly
+  // guess : const int
+  //  - the value of the move in the last iteration, or the minimum integer if there was none
+  // depth : const int
+  //  - the number of moves to search ahead of child
+  //
+  // returns
+  // -------
+  // int
+  //  - the value of the move if it is above floor, otherwise at most floor
+  //
+
+  constexpr int kNoGuess=std::numeric_limits<int>::min();
+  switch (this->driver)
+  {
+    case DRIVER::kPrincipalVariation:
+    {
+      // the first move has nothing to beat
+      if (floor==-kWin) { break; }
+      const int val=-this->negamax<false>(worker,child,-floor-1,-floor,1,depth);
+      if (val<=floor||this->expired) { return val; }
+      return -this->negamax<false>(worker,child,-kWin,-floor,1,depth);
+    }
+    case DRIVER::kAspiration:
+    {
+      // the first iteration has nothing to aim for
+      if (guess==kNoGuess) { break; }
+      const int lower=std::max(floor,guess-kAspirationWindow),upper=std::min(kWin,guess+kAspirationWindow);
+      const int val=-this->negamax<false>(worker,child,-upper,-lower,1,depth);
+      if (this->expired) { return val; }
+      // the value is at least val, so search above it
+      if (val>=upper&&upper<kWin) { return -this->negamax<false>(worker,child,-kWin,-std::max(floor,val-1),1,depth); }
+      // the value is at most val, and is only needed above floor
+      if (val<=lower&&lower>floor) { return -this->negamax<false>(worker,child,-val-1,-floor,1,depth); }
+      return val;
+    }
+    case DRIVER::kMTDf:
+    {
+      // the value lies in (lower,upper], and val is the latest bound on it
+      int lower=floor,upper=kWin,val=guess==kNoGuess ? 0 : std::clamp(guess,floor+1,kWin);
+      while (lower<upper&&!this->expired)
+      {
+        const int beta=std::max(val,lower+1);
+        val=-this->negamax<false>(worker,child,-beta,-beta+1,1,depth);
+        if (val<beta) { upper=val; }
+        else { lower=val; }
+      }
+      return val;
+    }
+    case DRIVER::kAlphaBeta:
+      break;
+  }
+  return -this->negamax<false>(worker,child,-kWin,-floor,1,depth);
+}
+
+template <int M, int N, int K>
+template <bool Maximising>
+int BasicMENACE<M,N,K>::negamax(Worker &worker, BasicBoard<M,N,K> &state, int alpha, int beta, const int ply, const int depth)
 {
   //
-  // Determine value of a given board
-  // Recursively applies minimax to all child boards of the input board to determine its value
-  // Uses alpha-beta pruning to reduce the search tree
+  // Determine value of a given board to the side to move
+  // Recursively applies negamax to all child boards of the input board, the value of a board being the best of the negated values of
+  // its children
+  // Uses alpha-beta pruning to reduce the search tree, and this->evaluations to evaluate each class of isometries once
+  // Children are tried in the order given by order_moves, so the best move is usually tried first and the rest are pruned
+  // A win in one, a threat which must be blocked, and two threats which cannot be, are found from the board's threats without
+  // searching the children
+  // Children are made and unmade on state itself, which is returned unchanged
+  // The side to move is a template parameter, so its value is fixed at compile time
+  // With SEARCH::kYoungBrothers, once the first child is searched the rest are split off to be shared with other threads, and a
+  // search whose split point has been cut off returns at once without saving anything, as does a search which has run out of time
+  // or boards
+  // A board reached at the depth of the search is scored by the lines each side could still complete, rather than searched
+  //
+  // template parameters
+  // -------------------
+  // Maximising : bool
+  //  - if the side to move is MENACE or its opponent
   //
   // parameters
   // ----------
-  // state : const Board &
+  // worker : Worker &
+  //  - the move ordering and node count of the thread searching
+  // state : BasicBoard<M,N,K> &
   //  - the Board to evaluate
   // alpha : int
-  //  - the worst value the maximising player can be gauranteed
+  //  - the worst value the side to move can be gauranteed
   // beta : int
-  //  - the worst value the minimising player can be gauranteed
-  // maximising_player : const bool
-  //  - if the player calling minimax seeks to maximise the value they obtain
-  // maximiser_value : const VALUE
-  //  - the VALUE of the player maximising the output of the board
-  // minimiser_value : const VALUE
-  //  - the VALUE of the player minimising the output of the board
+  //  - the worst value the other side can be gauranteed, negated
+  // ply : const int
+  //  - the number of moves made since the root of the search
+  // depth : const int
+  //  - the number of moves to search ahead of the board
   //
   // returns
   // -------
   // int
-  //  - the value of the input board
+  //  - the value of the input board to the side to move: kWin for a win, 0 for a draw, and -kWin for a loss, or between -kWin and
+  //    kWin for a board scored at the depth of the search
   //
 
-  // board has already been evaluated
-  if (int n;(n=find(this->evaluated_boards,state))!=-1)
+  ++worker.nodes;
+  // reading the clock is slow, so the limits are only checked now and then
+  if (worker.nodes%kCheckInterval==0) { this->check_limits(); }
+  // the value would be thrown away
+  if (this->expired||(worker.split&&worker.split->cancelled())) { return 0; }
+  const VALUE player_val=Maximising ? this->value : opposite(this->value);
+  const int empties=popcount(state.get_empty());
+  // searching past the end of the game is searching to the end of the game
+  const int draft=std::min(depth,empties);
+  // board has already been evaluated, or has a bound in the table which settles its value
+  // the table keeps the best move on the board of the class whose hash is the key, which isometry moves state to
+  const int isometry=state.symmetric_isometry();
+  const std::uint64_t key=state.symmetric_hash()^(player_val==VALUE::kNought ? kNoughtToMove : 0);
+  int hash_move;
+  if (int val;this->evaluations.probe(key,draft,alpha,beta,val,hash_move))
   {
-    return this->evaluations[n];
+    return val;
   }
   // board has been won
   if (RESULT res;(res=state.check_board())!=RESULT::kNotWon)
   {
-    // 0 if draw, 1 if won, -1 if lost
-    int val=res==RESULT::kDraw ? 0 : res==static_cast<RESULT>(maximiser_value) ? 1 : -1;
-    // save the board and its value
-    this->evaluated_boards.push_back(state);
-    this->evaluations.push_back(val);
+    // 0 if draw, kWin if won, -kWin if lost
+    int val=res==RESULT::kDraw ? 0 : res==static_cast<RESULT>(player_val) ? kWin : -kWin;
+    // save the board's value
+    this->evaluations.store(key,val,BOUND::kExact,empties);
     return val;
   }
-  // else consider all children states of the current state
-  std::vector<POSITION> possible=this->determine_possible_moves(state);
-
-  int val=maximising_player ? -1 : 1; // worst the player can be gauranteed
-  const bool maximising_child=!maximising_player;
-  const VALUE player_val=maximising_player ? maximiser_value : minimiser_value;
-
-  const std::function<const int &(const int &, const int &)> comparator=maximising_player ?
-    static_cast<const int &(*)(const int &, const int &)>(&std::max<int>) :
-    static_cast<const int &(*)(const int &, const int &)>(&std::min<int>);
-  int &pruner=maximising_player ? beta : alpha;
-  
-  // consider all child states
-  for (POSITION pos:possible)
+
+  // a line which can be completed wins at once, so no child need be made
+  if (state.get_winning_moves(player_val)) { return kWin; }
+  // two lines of the other side cannot both be blocked, and one must be, so it is the only move
+  const typename BasicBoard<M,N,K>::mask_type blocks=state.get_blocking_moves(player_val);
+  if (blocks&(blocks-1)) { return -kWin; }
+  // the search goes no deeper, so the board is scored instead, short of a win or a loss
+  if (draft==0) { return std::clamp(state.get_line_score(player_val),-kWin+1,kWin-1); }
+
+  int val=-kWin; // worst the player can be gauranteed
+  int best=kNoMove;
+  // the window the board is searched with, which decides if its value is exact or a bound
+  const int original_alpha=alpha;
+
+  // consider all child states, most promising first
+  if (hash_move!=kNoMove)
   {
-    // create the child
-    Board child=state;
-    child.assign_position(pos,player_val);
+    hash_move=static_cast<int>(BasicBoard<M,N,K>::apply_isometry(static_cast<POSITION>(hash_move)
+      ,BasicBoard<M,N,K>::kInverseIsometries[isometry]));
+  }
+  const MoveList<kPositions> moves=blocks ? MoveList<kPositions>(blocks) : this->order_moves(worker,state,ply,player_val,hash_move);
+  for (size_t itr=0;itr<moves.size();++itr)
+  {
+    // the first child has not caused a cut off, so the rest are likely all needed, and can be searched at once
+    if (itr==1&&moves.size()>2&&this->search==SEARCH::kYoungBrothers&&draft>=kSplitDepth)
+    {
+      val=this->split<Maximising>(worker,state,moves,itr,alpha,beta,val,ply,draft,best);
+      break;
+    }
+    const POSITION pos=moves[itr];
+    // move to the child
+    state.make_move_unchecked(pos,player_val);
     // determine its value
-    val=comparator(this->minimax(child,alpha,beta,maximising_child,maximiser_value,minimiser_value),val);
-    pruner=comparator(pruner,val);
-    // the decision tree can be pruned
-    if (alpha>=beta) { break; }
+    // with DRIVER::kPrincipalVariation, the children after the first are expected to be worse, which a null window shows cheaply
+    int child;
+    if (itr==0||this->driver!=DRIVER::kPrincipalVariation)
+    {
+      child=-this->negamax<!Maximising>(worker,state,-beta,-alpha,ply+1,draft-1);
+    }
+    else if ((child=-this->negamax<!Maximising>(worker,state,-alpha-1,-alpha,ply+1,draft-1))>alpha&&child<beta)
+    {
+      child=-this->negamax<!Maximising>(worker,state,-beta,-alpha,ply+1,draft-1);
+    }
+    state.unmake_move_unchecked(pos,player_val);
+    if (child<=val) { continue; }
+    val=child;
+    best=static_cast<int>(pos);
+    alpha=std::max(alpha,val);
+    // the decision tree can be pruned, and the move which caused it is tried early elsewhere
+    if (alpha>=beta)
+    {
+      this->record_cutoff<Maximising>(worker,pos,ply,draft);
+      break;
+    }
   }
-  // save the board and its value
-  this->evaluated_boards.push_back(state);
-  this->evaluations.push_back(val);
+  // the children were not all searched
+  if (this->expired||(worker.split&&worker.split->cancelled())) { return 0; }
+  // save the board's value, or the bound on it if the search failed outside of its window
+  const BOUND bound=val<=original_alpha ? BOUND::kUpper : val>=beta ? BOUND::kLower : BOUND::kExact;
+  // a win or a loss found by a shallow search holds however deep the board is searched
+  const bool proven=(val==kWin&&bound!=BOUND::kUpper)||(val==-kWin&&bound!=BOUND::kLower);
+  // a search which failed low shows no move to be better than another, so any move kept from an earlier search is kept
+  this->evaluations.store(key,val,bound,proven ? empties : draft,best==kNoMove||bound==BOUND::kUpper ? kNoMove
+    : static_cast<int>(BasicBoard<M,N,K>::apply_isometry(static_cast<POSITION>(best),isometry)));
   return val;
 }
 
-void MENACE::clear_tansposition_table(void)
+template <int M, int N, int K>
+template <bool Maximising>
+int BasicMENACE<M,N,K>::split(Worker &worker, const BasicBoard<M,N,K> &state, const MoveList<kPositions> &moves, const size_t first
+  , const int alpha, const int beta, const int val, const int ply, const int depth, int &move)
 {
   //
-  // Clear both this->evaluated_boards and this->evaluations
+  // Search the remaining children of a board with any threads which are free
+  // The children are put on the back of worker.tasks, and searched by this thread from the back and by other threads from the front
+  // While other threads search the last of them, this thread searches what other threads have split off
+  //
+  // template parameters
+  // -------------------
+  // Maximising : bool
+  //  - if the side to move is MENACE or its opponent
+  //
+  // parameters
+  // ----------
+  // worker : Worker &
+  //  - the thread splitting the board
+  // state : const BasicBoard<M,N,K> &
+  //  - the Board to split, which is left unchanged until its children are done
+  // moves : const MoveList<kPositions> &
+  //  - the children of state, in the order to search them
+  // first : const size_t
+  //  - the index in moves of the first child not yet searched
+  // alpha : const int
+  //  - the worst value the side to move can be gauranteed
+  // beta : const int
+  //  - the worst value the other side can be gauranteed, negated
+  // val : const int
+  //  - the value of the best child searched so far
+  // ply : const int
+  //  - the number of moves made since the root of the search
+  // depth : const int
+  //  - the number of moves to search ahead of state
+  // move : int &
+  //  - the best move searched so far, set to the best move of all
   //
+  // returns
+  // -------
+  // int
+  //  - the value of state to the side to move, bounded as by negamax
+  //
+
+  const VALUE player_val=Maximising ? this->value : opposite(this->value);
+  SplitPoint split(state,worker.split,player_val,ply,depth,alpha,beta,val,move,static_cast<int>(moves.size()-first));
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (size_t itr=first;itr<moves.size();++itr) { worker.tasks.push_back(Task{&split,moves[itr]}); }
+  }
+  // split lives on this thread's stack, so it must not be left until no thread is searching its children
+  while (split.pending>0)
+  {
+    std::optional<Task> task;
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (!worker.tasks.empty())
+      {
+        task=worker.tasks.back();
+        worker.tasks.pop_back();
+      }
+    }
+    if (task) { this->run_task(worker,*task); }
+    else if (!this->steal(worker)) { std::this_thread::yield(); }
+  }
+  move=split.move;
+  return split.val;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::run_task(Worker &worker, const Task &task)
+{
+  //
+  // Search a child of a split point, and raise the split point's value by it
+  // The child is not searched if the split point has been cut off, and is counted as done either way
+  //
+  // parameters
+  // ----------
+  // worker : Worker &
+  //  - the thread searching the child
+  // task : const Task &
+  //  - the child to search
+  //
+
+  SplitPoint &split=*task.split;
+  if (!split.cancelled())
+  {
+    const bool maximising=split.player_val==this->value;
+    BasicBoard<M,N,K> state=split.state;
+    state.make_move_unchecked(task.pos,split.player_val);
+    const SplitPoint *const outer=worker.split;
+    worker.split=&split;
+    const int alpha=split.alpha;
+    const int child=maximising ? -this->negamax<false>(worker,state,-split.beta,-alpha,split.ply+1,split.depth-1)
+      : -this->negamax<true>(worker,state,-split.beta,-alpha,split.ply+1,split.depth-1);
+    worker.split=outer;
+
+    std::lock_guard<std::mutex> lock(split.mutex);
+    if (!split.cancelled()&&child>split.val)
+    {
+      split.val=child;
+      split.move=static_cast<int>(task.pos);
+      split.alpha=std::max<int>(split.alpha,child);
+      // the children still to be searched are not needed
+      if (split.alpha>=split.beta)
+      {
+        split.cutoff=true;
+        if (maximising) { this->record_cutoff<true>(worker,task.pos,split.ply,split.depth); }
+        else { this->record_cutoff<false>(worker,task.pos,split.ply,split.depth); }
+      }
+    }
+  }
+  // the last use of split, as the thread which split the board may leave it once every child is done
+  --split.pending;
+}
+
+template <int M, int N, int K>
+bool BasicMENACE<M,N,K>::steal(Worker &worker)
+{
+  //
+  // Search a child split off by another thread, taking the oldest, as it is likely the largest
+  //
+  // parameters
+  // ----------
+  // worker : Worker &
+  //  - the thread which is free
+  //
+  // returns
+  // -------
+  // bool
+  //  - if a child was found to search
+  //
+
+  const size_t self=static_cast<size_t>(&worker-this->workers.data()),count=this->workers.size();
+  for (size_t itr=1;itr<count;++itr)
+  {
+    Worker &other=this->workers[(self+itr)%count];
+    std::optional<Task> task;
+    {
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (other.tasks.empty()) { continue; }
+      task=other.tasks.front();
+      other.tasks.pop_front();
+    }
+    this->run_task(worker,*task);
+    return true;
+  }
+  return false;
+}
 
-  this->evaluated_boards.clear();
+template <int M, int N, int K>
+template <bool Maximising>
+void BasicMENACE<M,N,K>::record_cutoff(Worker &worker, const POSITION pos, const int ply, const int depth) const
+{
+  //
+  // Make a move which caused a cut off a killer move of its ply, and raise its history
+  //
+  // template parameters
+  // -------------------
+  // Maximising : bool
+  //  - if the side which made the move is MENACE or its opponent
+  //
+  // parameters
+  // ----------
+  // worker : Worker &
+  //  - the thread which found the cut off
+  // pos : const POSITION
+  //  - the move which caused the cut off
+  // ply : const int
+  //  - the number of moves made since the root of the search to the board the move was made on
+  // depth : const int
+  //  - the number of moves searched ahead of the board the move was made on
+  //
+
+  std::array<int,2> &killer=worker.killers[ply];
+  if (killer[0]!=static_cast<int>(pos))
+  {
+    killer[1]=killer[0];
+    killer[0]=static_cast<int>(pos);
+  }
+  std::uint32_t &score=worker.history[Maximising][static_cast<int>(pos)];
+  score=static_cast<std::uint32_t>(std::min<std::uint64_t>(std::uint64_t{score}+depth*depth,std::numeric_limits<std::uint32_t>::max()));
+}
+
+template <int M, int N, int K>
+MoveList<BasicMENACE<M,N,K>::kPositions> BasicMENACE<M,N,K>::order_moves(const Worker &worker, const BasicBoard<M,N,K> &state
+  , const int ply, const VALUE player_val, const int hash_move) const
+{
+  //
+  // Order the moves of a board, most promising first
+  // Of moves which give the same board up to an isometry, only one is given
+  // The best move found for the board by an earlier search comes first, then killer moves of the ply, then moves by their history,
+  // then by the number of winning combinations they lie on, which puts the centre of the 3x3 board first, then its corners, then its
+  // edges
+  // With SEARCH::kLazySMP, each thread breaks ties between moves differently, so the threads search different boards first
+  //
+  // parameters
+  // ----------
+  // worker : const Worker &
+  //  - the killer moves and history of the thread searching
+  // state : const BasicBoard<M,N,K> &
+  //  - the Board to order the moves of
+  // ply : const int
+  //  - the number of moves made since the root of the search
+  // player_val : const VALUE
+  //  - the value of the side to move
+  // hash_move : const int
+  //  - the best move kept for state in the transposition table, or kNoMove
+  //
+  // returns
+  // -------
+  // MoveList<kPositions>
+  //  - the distinct empty positions of state, in the order to search them
+  //
+
+  MoveList<kPositions> moves(state.get_distinct_empty());
+  const std::array<int,2> &killer=worker.killers[ply];
+  const std::array<std::uint32_t,kPositions> &side=worker.history[player_val==this->value];
+
+  std::array<std::uint64_t,kPositions> scores;
+  for (POSITION pos:moves)
+  {
+    const int idx=static_cast<int>(pos);
+    const std::uint64_t lines=static_cast<std::uint64_t>(popcount(BasicBoard<M,N,K>::kPositionLines[idx]));
+    const std::uint64_t killed=idx==hash_move ? 3 : idx==killer[0] ? 2 : idx==killer[1] ? 1 : 0;
+    scores[idx]=killed<<62|static_cast<std::uint64_t>(side[idx])<<8|lines;
+  }
+  if (const size_t thread=static_cast<size_t>(&worker-this->workers.data());this->search==SEARCH::kLazySMP&&thread!=0)
+  {
+    std::rotate(std::begin(moves),std::begin(moves)+(thread*(ply+1))%moves.size(),std::end(moves));
+  }
+  // a stable sort, so equal moves stay in board order
+  std::stable_sort(std::begin(moves),std::end(moves),[&scores](const POSITION lhs, const POSITION rhs)
+    { return scores[static_cast<int>(lhs)]>scores[static_cast<int>(rhs)]; });
+  return moves;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::clear_tansposition_table(void)
+{
+  //
+  // Remove every board from this->evaluations, releasing its memory
+  //
+
+  // a search on the opponent's time uses what is changed
+  this->stop_pondering();
   this->evaluations.clear();
 }
 
-[[nodiscard]] PLAYER MENACE::ident(void) const
+template <int M, int N, int K>
+[[nodiscard]] PLAYER BasicMENACE<M,N,K>::ident(void) const
 {
   return PLAYER::kMENACE;
 }
 
-Random::Random(const VALUE value, Board &board) : Automaton(value,board)
+template <int M, int N, int K>
+[[nodiscard]] std::uint64_t BasicMENACE<M,N,K>::get_nodes(void) const
+{
+  //
+  // Get the number of boards visited by the last search
+  // Boards settled by the transposition table count, so the number measures the work of the search
+  //
+  // returns
+  // -------
+  // std::uint64_t
+  //  - the number of calls to negamax in the last search, over all threads, 0 if MENACE has not searched
+  //
+
+  std::uint64_t nodes=0;
+  for (const Worker &worker:this->workers) { nodes+=worker.nodes; }
+  return nodes;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] int BasicMENACE<M,N,K>::get_depth(void) const
+{
+  //
+  // Get how far ahead the last search looked
+  //
+  // returns
+  // -------
+  // int
+  //  - the number of moves searched ahead by the last iteration the last search completed, 0 if MENACE has not searched
+  //
+
+  return this->depth;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] StopToken BasicMENACE<M,N,K>::get_stop_token(void) const
+{
+  //
+  // Get a token through which MENACE's searches can be stopped from another thread
+  // Searches check the token each time a thread has visited kCheckInterval boards
+  //
+  // returns
+  // -------
+  // StopToken
+  //  - a copy of this->stop, sharing its request
+  //
+
+  return this->stop;
+}
+
+template <int M, int N, int K>
+[[nodiscard]] std::optional<POSITION> BasicMENACE<M,N,K>::get_expected_move(void) const
+{
+  //
+  // Get the move MENACE expects of its opponent while it is pondering
+  //
+  // returns
+  // -------
+  // std::optional<POSITION>
+  //  - the move whose board is searched on the opponent's time, or empty if MENACE is not pondering
+  //
+
+  return this->expected;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::set_limits(const std::chrono::milliseconds time, const std::uint64_t nodes)
+{
+  //
+  // Limit the time and the number of boards MENACE may take to choose each move
+  // A limited search looks one move further ahead each iteration, and stops within kCheckInterval boards per thread of running out,
+  // giving the best move of the last iteration it completed; the first iteration is always completed
+  //
+  // parameters
+  // ----------
+  // time : const std::chrono::milliseconds
+  //  - the time each move may take, or zero for no limit
+  // nodes : const std::uint64_t
+  //  - the number of boards each move may visit, over all threads, or zero for no limit
+  //
+  // throws
+  // ------
+  // std::invalid_argument
+  //  - if time is negative
+  //
+
+  if (time.count()<0) { throw std::invalid_argument("A search cannot be given negative time."); }
+  // a search on the opponent's time uses what is changed
+  this->stop_pondering();
+  this->time_limit=time;
+  this->node_limit=nodes;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::set_driver(const DRIVER driver)
+{
+  //
+  // Set how MENACE searches for the value of each move
+  // Every driver gives the same values, but the number of boards each visits, given by BasicMENACE::get_nodes, differs by board
+  //
+  // parameters
+  // ----------
+  // driver : const DRIVER
+  //  - DRIVER::kAlphaBeta, DRIVER::kPrincipalVariation, DRIVER::kAspiration, or DRIVER::kMTDf
+  //
+
+  // a search on the opponent's time uses what is changed
+  this->stop_pondering();
+  this->driver=driver;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::set_search(const SEARCH search, const int threads)
+{
+  //
+  // Set how MENACE's searches are spread over threads
+  // The threads are started here, and kept until the search is next set, so no search pays to start them
+  //
+  // parameters
+  // ----------
+  // search : const SEARCH
+  //  - SEARCH::kSerial to search on the calling thread alone, SEARCH::kRoot to share the moves of the board between threads, or
+  //    SEARCH::kYoungBrothers to share the children of every board deep enough to be worth it, or SEARCH::kLazySMP for every thread
+  //    to search the whole tree, sharing only the transposition table
+  // threads : const int
+  //  - the number of threads to search with, including the calling thread; ignored for SEARCH::kSerial
+  //
+  // throws
+  // ------
+  // std::invalid_argument
+  //  - if threads is less than 1
+  //
+
+  if (threads<1) { throw std::invalid_argument("A search must have at least one thread."); }
+  // a search on the opponent's time uses what is changed
+  this->stop_pondering();
+  const int count=search==SEARCH::kSerial ? 1 : threads;
+  this->search=search;
+  this->workers=std::vector<Worker>(count);
+  this->pool=count>1 ? std::make_unique<ThreadPool>(count) : nullptr;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::check_limits(void)
+{
+  //
+  // Count kCheckInterval more boards against the running search, and stop it if it has run out of time or boards, or has been asked
+  // to stop
+  // A search on the opponent's time has no limits until the opponent makes the move it expected
+  //
+
+  const std::uint64_t spent=this->spent+=kCheckInterval;
+  if (this->stop.requested()!=STOP::kNone||(!this->pondering&&((this->node_limit!=0&&spent>=this->node_limit)
+    ||(this->time_limit.count()!=0&&std::chrono::steady_clock::now()>=this->deadline.load())))) { this->expired=true; }
+}
+
+template <int M, int N, int K>
+[[nodiscard]] bool BasicMENACE<M,N,K>::limited(void) const
+{
+  //
+  // Determine if searches are limited in time or boards
+  //
+  // returns
+  // -------
+  // bool
+  //  - if either limit is set
+  //
+
+  return this->time_limit.count()!=0||this->node_limit!=0;
+}
+
+template <int M, int N, int K>
+void BasicMENACE<M,N,K>::Worker::clear(void)
+{
+  //
+  // Forget the move ordering and node count of the last search
+  //
+
+  for (std::array<int,2> &killer:this->killers) { killer.fill(kNoMove); }
+  for (std::array<std::uint32_t,kPositions> &side:this->history) { side.fill(0); }
+  this->nodes=0;
+  this->tasks.clear();
+  this->split=nullptr;
+}
+
+template <int M, int N, int K>
+BasicMENACE<M,N,K>::SplitPoint::SplitPoint(const BasicBoard<M,N,K> &state, const SplitPoint *parent, const VALUE player_val
+  , const int ply, const int depth, const int alpha, const int beta, const int val, const int move, const int pending)
+  : state(state), parent(parent), player_val(player_val), ply(ply), depth(depth), beta(beta), mutex(), alpha(alpha), val(val)
+  , move(move), pending(pending), cutoff(false)
+{
+  //
+  // SplitPoint class constructor
+  //
+  // parameters
+  // ----------
+  // state : const BasicBoard<M,N,K> &
+  //  - the board split
+  // parent : const SplitPoint *
+  //  - the split point state was reached from, or nullptr
+  // player_val : const VALUE
+  //  - the value of the side to move
+  // ply : const int
+  //  - the number of moves made since the root of the search
+  // depth : const int
+  //  - the number of moves to search ahead of state
+  // alpha : const int
+  //  - the worst value the side to move can be gauranteed
+  // beta : const int
+  //  - the worst value the other side can be gauranteed, negated
+  // val : const int
+  //  - the value of the best child searched before the split
+  // move : const int
+  //  - the best child searched before the split, or kNoMove
+  // pending : const int
+  //  - the number of children split off
+  //
+}
+
+template <int M, int N, int K>
+[[nodiscard]] bool BasicMENACE<M,N,K>::SplitPoint::cancelled(void) const
+{
+  //
+  // Determine if the children of the split point are no longer needed
+  //
+  // returns
+  // -------
+  // bool
+  //  - if the split point, or any it was reached from, has been cut off
+  //
+
+  for (const SplitPoint *split=this;split;split=split->parent)
+  {
+    if (split->cutoff) { return true; }
+  }
+  return false;
+}
+
+template <int M, int N, int K>
+BasicRandom<M,N,K>::BasicRandom(const VALUE value, BasicBoard<M,N,K> &board) : BasicAutomaton<M,N,K>(value,board)
 {
   //
   // Random class constructor
@@ -295,12 +1457,13 @@ Random::Random(const VALUE value, Board &board) : Automaton(value,board)
   // ----------
   // value : const VALUE
   //  - the value for the Random player to play
-  // board : Board &
+  // board : BasicBoard<M,N,K> &
   //  - the board for the Random player to play on
   //
 }
 
-POSITION Random::get_move(void)
+template <int M, int N, int K>
+POSITION BasicRandom<M,N,K>::get_move(void)
 {
   //
   // Get a move from a Random player
@@ -312,13 +1475,32 @@ POSITION Random::get_move(void)
   //
 
   // construct all possile moves, shuffle, and return
-  std::vector<POSITION> possible=this->determine_possible_moves();
+  MoveList<BasicBoard<M,N,K>::kPositions> possible=this->determine_possible_moves();
   std::shuffle(std::begin(possible),std::end(possible),std::mt19937_64{std::random_device{}()});
   return possible.front();
 }
 
-[[nodiscard]] PLAYER Random::ident(void) const
+template <int M, int N, int K>
+[[nodiscard]] PLAYER BasicRandom<M,N,K>::ident(void) const
 {
   return PLAYER::kRandom;
 }
+
+// the boards the players are built for
+template class BasicPlayer<3,3,3>;
+template class BasicAutomaton<3,3,3>;
+template class BasicMENACE<3,3,3>;
+template class BasicRandom<3,3,3>;
+template class BasicPlayer<4,4,3>;
+template class BasicAutomaton<4,4,3>;
+template class BasicMENACE<4,4,3>;
+template class BasicRandom<4,4,3>;
+template class BasicPlayer<5,5,4>;
+template class BasicAutomaton<5,5,4>;
+template class BasicMENACE<5,5,4>;
+template class BasicRandom<5,5,4>;
+template class BasicPlayer<7,7,5>;
+template class BasicAutomaton<7,7,5>;
+template class BasicMENACE<7,7,5>;
+template class BasicRandom<7,7,5>;
 } // namespace menace
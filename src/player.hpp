@@ -14,77 +14,232 @@
 #ifndef PLAYER_H__
 #define PLAYER_H__
 
-#include <functional>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <thread>
+#include <vector>
 
 #include <board.hpp>
+#include <threadpool.hpp>
+#include <transposition.hpp>
 
 namespace menace
 {
 // Exceptions
 class assigning_empty_player : public std::exception {};
+class search_aborted : public std::exception {};
 
 // Classes
+// a move of the board in play, its value to the side making it, and the moves expected to follow it
+class MoveEvaluation
+{
+public:
+  POSITION pos;
+  int value;
+  // the principal variation, starting with pos, if it was asked for
+  std::vector<POSITION> variation;
+};
+
 // Player is directly used for humans, inherited for the computer
-class Player
+template <int M, int N, int K>
+class BasicPlayer
 {
 public:
-  Player(const VALUE value, Board &board);
+  BasicPlayer(const VALUE value, BasicBoard<M,N,K> &board);
   void make_move(POSITION pos) const;
+  ASSIGNMENT try_make_move(const POSITION pos) const noexcept;
   
   const VALUE value;
 
   [[nodiscard]] virtual PLAYER ident(void) const;
 
 protected:
-  Board &board;
+  BasicBoard<M,N,K> &board;
 };
 
 // virtual base for Random and MENACE
-class Automaton : public Player
+template <int M, int N, int K>
+class BasicAutomaton : public BasicPlayer<M,N,K>
 {
 public:
-  Automaton(const VALUE value, Board &board);
+  BasicAutomaton(const VALUE value, BasicBoard<M,N,K> &board);
   virtual POSITION get_move(void)=0;
+  virtual void ponder(void);
+  virtual void stop_pondering(void);
 
   [[nodiscard]] virtual PLAYER ident(void) const=0;
 
 protected:
-  bool valid_move(const Board &state, POSITION pos) const;
+  bool valid_move(const BasicBoard<M,N,K> &state, POSITION pos) const;
   bool valid_move(const POSITION pos) const;
 
-  std::vector<POSITION> determine_possible_moves(void) const;
-  std::vector<POSITION> determine_possible_moves(const Board &state) const;
+  MoveList<BasicBoard<M,N,K>::kPositions> determine_possible_moves(void) const;
+  MoveList<BasicBoard<M,N,K>::kPositions> determine_possible_moves(const BasicBoard<M,N,K> &state) const;
 };
 
-class MENACE : public Automaton
+template <int M, int N, int K>
+class BasicMENACE : public BasicAutomaton<M,N,K>
 {
+  static constexpr int kPositions=BasicBoard<M,N,K>::kPositions;
+  // the 3x3 board is solved at compile time
+  static constexpr bool kSolved=std::is_same<BasicBoard<M,N,K>,Board>::value;
+  // marks an empty killer move, or a board with no best move in the table
+  static constexpr int kNoMove=TranspositionTable::kNoMove;
+  // the limits of a search are checked each time a thread has visited this many boards
+  static constexpr std::uint64_t kCheckInterval=1024;
+  // how far either side of its value in the last iteration a move is first searched with DRIVER::kAspiration
+  static constexpr int kAspirationWindow=16;
+  // mixed into the key of a board with nought to move, as a board's value depends on which side is to move
+  static constexpr std::uint64_t kNoughtToMove=0x9e3779b97f4a7c15;
+  // boards with fewer empty positions than this are searched by one thread, as sharing them costs more than they take
+  static constexpr int kSplitDepth=5;
+
+  // a board whose children after the first are searched by any thread which is free, with SEARCH::kYoungBrothers
+  // it lives on the stack of the thread which split the board, which waits until every child is done
+  class SplitPoint
+  {
+  public:
+    SplitPoint(const BasicBoard<M,N,K> &state, const SplitPoint *parent, const VALUE player_val, const int ply, const int depth
+      , const int alpha, const int beta, const int val, const int move, const int pending);
+
+    [[nodiscard]] bool cancelled(void) const;
+
+    // the board split, left unchanged until every child is done
+    const BasicBoard<M,N,K> &state;
+    // the split point the board was reached from, if any, whose cut off makes this one's children worthless too
+    const SplitPoint *const parent;
+    const VALUE player_val;
+    const int ply,depth,beta;
+    // the window, value, and best move of the board so far, raised as children are done
+    std::mutex mutex;
+    std::atomic<int> alpha,val;
+    int move;
+    // the number of children not yet done, and if one has caused a cut off
+    std::atomic<int> pending;
+    std::atomic<bool> cutoff;
+  };
+
+  // a child of a split point, waiting for a thread to search it
+  class Task
+  {
+  public:
+    SplitPoint *split;
+    POSITION pos;
+  };
+
+  // what each thread of a search keeps to itself
+  class Worker
+  {
+  public:
+    void clear(void);
+
+    // the two most recent moves at each ply which caused a cut off, tried before all others but the static ordering
+    std::array<std::array<int,2>,kPositions+1> killers;
+    // for each side, how much each position has caused cut offs, weighted to those high in the tree
+    std::array<std::array<std::uint32_t,kPositions>,2> history;
+    // the number of boards visited by the thread in the last search
+    std::uint64_t nodes;
+    // the children the thread has split off, newest at the back, which other threads take from the front
+    std::deque<Task> tasks;
+    std::mutex mutex;
+    // the split point of the child being searched by the thread, if any
+    const SplitPoint *split;
+  };
+
 public:
-  MENACE(const VALUE value, Board &board);
+  // the value of a won board; boards scored at the depth of a search lie strictly between a loss and a win
+  static constexpr int kWin=100;
+
+  BasicMENACE(const VALUE value, BasicBoard<M,N,K> &board, const size_t table_bytes=TranspositionTable::kDefaultBytes);
+  ~BasicMENACE();
 
   POSITION get_move(void);
+  void ponder(void);
+  void stop_pondering(void);
+  std::vector<MoveEvaluation> evaluate_moves(const bool variations=false);
+  static POSITION choose_move(const std::vector<MoveEvaluation> &evaluation);
   void clear_tansposition_table(void);
+  void set_search(const SEARCH search, const int threads);
+  void set_limits(const std::chrono::milliseconds time, const std::uint64_t nodes);
+  void set_driver(const DRIVER driver);
 
   [[nodiscard]] PLAYER ident(void) const;
+  [[nodiscard]] std::uint64_t get_nodes(void) const;
+  [[nodiscard]] int get_depth(void) const;
+  [[nodiscard]] StopToken get_stop_token(void) const;
+  [[nodiscard]] std::optional<POSITION> get_expected_move(void) const;
 
 private:
-  int minimax(const Board &state, int alpha, int beta, const bool maximising_player, const VALUE maximiser_value
-    , const VALUE minimiser_value);
+  POSITION search_move(void);
+  std::array<int,kPositions> search_values(const BasicBoard<M,N,K> &root, const bool exact);
+  std::vector<POSITION> principal_variation(const POSITION pos);
+  int table_move(const BasicBoard<M,N,K> &state, const VALUE player_val);
+  void search_root(const BasicBoard<M,N,K> &root, const MoveList<kPositions> &possible, const int symmetries, const int depth
+    , const std::array<int,kPositions> &guesses, const bool exact, std::array<int,kPositions> &values);
+  int search_child(Worker &worker, BasicBoard<M,N,K> &child, const int floor, const int guess, const int depth);
+  template <bool Maximising>
+  int negamax(Worker &worker, BasicBoard<M,N,K> &state, int alpha, int beta, const int ply, const int depth);
+  MoveList<kPositions> order_moves(const Worker &worker, const BasicBoard<M,N,K> &state, const int ply, const VALUE player_val
+    , const int hash_move) const;
+  template <bool Maximising>
+  int split(Worker &worker, const BasicBoard<M,N,K> &state, const MoveList<kPositions> &moves, const size_t first, const int alpha
+    , const int beta, const int val, const int ply, const int depth, int &move);
+  template <bool Maximising>
+  void record_cutoff(Worker &worker, const POSITION pos, const int ply, const int depth) const;
+  void run_task(Worker &worker, const Task &task);
+  bool steal(Worker &worker);
+  void check_limits(void);
+  [[nodiscard]] bool limited(void) const;
 
   
-  // transposition table
-  std::vector<Board> evaluated_boards;
-  std::vector<int> evaluations;
+  // transposition table, keyed by the hash of each board's class of isometries, in a fixed amount of memory, shared by all threads
+  TranspositionTable evaluations;
+  // how the value of each move is searched for
+  DRIVER driver;
+  // how searches are spread over threads, the state of each thread, and the threads other than the calling thread
+  SEARCH search;
+  std::vector<Worker> workers;
+  std::unique_ptr<ThreadPool> pool;
+  // the time and number of boards each search may take, neither limited if zero
+  std::chrono::milliseconds time_limit;
+  std::uint64_t node_limit;
+  // when the running search must stop, the boards its threads have visited, counted kCheckInterval at a time, and if it has stopped
+  // while the search is on the opponent's time, it has no limits until their move is the one it expected
+  std::atomic<std::chrono::steady_clock::time_point> deadline;
+  std::atomic<std::uint64_t> spent;
+  std::atomic<bool> expired,pondering;
+  // the depth of the last iteration the last search completed
+  int depth;
+  // asks the running search to stop, from any thread
+  StopToken stop;
+  // the thread searching on the opponent's time, the move expected of them and the board after it, and the values of MENACE's moves
+  // on it, empty if the search was aborted
+  std::thread ponderer;
+  std::optional<POSITION> expected;
+  BasicBoard<M,N,K> pondered;
+  std::optional<std::array<int,kPositions>> pondered_values;
 };
 
-class Random : public Automaton
+template <int M, int N, int K>
+class BasicRandom : public BasicAutomaton<M,N,K>
 {
 public:
-  Random(const VALUE value, Board &board);
+  BasicRandom(const VALUE value, BasicBoard<M,N,K> &board);
   POSITION get_move(void);
 
   [[nodiscard]] PLAYER ident(void) const;
 };
+
+// the players of noughts and crosses
+using Player=BasicPlayer<3,3,3>;
+using Automaton=BasicAutomaton<3,3,3>;
+using MENACE=BasicMENACE<3,3,3>;
+using Random=BasicRandom<3,3,3>;
 } // namespace menace
 
 #endif // PLAYER_H__
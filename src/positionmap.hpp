@@ -0,0 +1,559 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// positionmap.hpp                                                                                                                       //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Container of values for boards of noughts and crosses, indexed directly by the board
+
+
+#pragma once
+
+#ifndef POSITIONMAP_H__
+#define POSITIONMAP_H__
+
+#include <board.hpp>
+
+namespace menace
+{
+// Classes
+template <typename T, INDEXING I>
+class PositionMap;
+
+// a board in a PositionMap and its value
+template <typename T>
+class PositionMapElement
+{
+public:
+  // the index of the board in the map
+  int index;
+  // the board of the index; the smallest board of the class, by rank, if the map is indexed by class
+  Board board;
+  T &value;
+};
+
+// iterates over the boards in a PositionMap, in index order
+// T is const for iterating over a const map
+template <typename T, INDEXING I>
+class PositionMapIterator
+{
+  using map_type=typename std::conditional<std::is_const<T>::value,const PositionMap<typename std::remove_const<T>::type,I>
+    ,PositionMap<T,I>>::type;
+
+  map_type *map;
+  int idx;
+
+public:
+  using pointer=void;
+  using reference=PositionMapElement<T>;
+
+  using iterator_category=std::forward_iterator_tag;
+  using difference_type=std::ptrdiff_t;
+  using value_type=PositionMapElement<T>;
+
+  PositionMapIterator(map_type *map, const int index) : map(map), idx(map->next(index)) {};
+
+  // dereference
+  reference operator*() const;
+  // increment
+  PositionMapIterator &operator++();
+  PositionMapIterator operator++(int);
+  // comparison
+  template <typename U, INDEXING J>
+  friend bool operator==(const PositionMapIterator<U,J> &lhs, const PositionMapIterator<U,J> &rhs);
+};
+
+// maps boards to values by indexing an array directly with the board's rank, legal index, or class index
+// a bitset marks which indices hold a value, so lookups and inserts are O(1) and nothing is allocated
+// indexed by class, all boards which match under an isometry share one value
+template <typename T, INDEXING I=INDEXING::kRank>
+class PositionMap
+{
+  template <typename U, INDEXING J>
+  friend class PositionMapIterator;
+
+public:
+  using iterator=PositionMapIterator<T,I>;
+  using const_iterator=PositionMapIterator<const T,I>;
+
+  // the number of indices of the map
+  static constexpr int kSize=I==INDEXING::kRank ? kRanks : I==INDEXING::kLegal ? kLegalPositions : kIsometryClasses;
+
+  PositionMap() : values(), present(), count(0) {};
+
+  bool insert(const Board &board, const T &value);
+  bool erase(const Board &board);
+  void clear(void);
+
+  // iterators
+  [[nodiscard]] iterator begin(void) { return iterator(this,0); };
+  [[nodiscard]] iterator end(void) { return iterator(this,kSize); };
+  [[nodiscard]] const_iterator begin(void) const { return const_iterator(this,0); };
+  [[nodiscard]] const_iterator end(void) const { return const_iterator(this,kSize); };
+
+  // getters
+  [[nodiscard]] bool contains(const Board &board) const;
+  [[nodiscard]] T *find(const Board &board);
+  [[nodiscard]] const T *find(const Board &board) const;
+  [[nodiscard]] T &at(const Board &board);
+  [[nodiscard]] const T &at(const Board &board) const;
+  [[nodiscard]] T &operator[](const Board &board);
+  [[nodiscard]] size_t size(void) const { return this->count; };
+  [[nodiscard]] bool empty(void) const { return this->count==0; };
+
+  // indexing
+  [[nodiscard]] static int index(const Board &board);
+  [[nodiscard]] static Board board(const int index);
+
+private:
+  std::array<T,kSize> values;
+  // bit n%64 of word n/64 is set if index n holds a value
+  std::array<std::uint64_t,(kSize+63)/64> present;
+  size_t count;
+
+  [[nodiscard]] bool has(const int index) const;
+  [[nodiscard]] int next(const int index) const;
+  [[nodiscard]] int checked_index(const Board &board) const;
+};
+
+// Inline Methods
+template <typename T, INDEXING I>
+inline typename PositionMapIterator<T,I>::reference PositionMapIterator<T,I>::operator*() const
+{
+  //
+  // PositionMapIterator dereference operator
+  //
+  // returns
+  // -------
+  // PositionMapElement<T>
+  //  - the index, the board, and a reference to the value the iterator is at
+  //
+
+  return {this->idx,map_type::board(this->idx),this->map->values[this->idx]};
+}
+
+template <typename T, INDEXING I>
+inline PositionMapIterator<T,I> &PositionMapIterator<T,I>::operator++()
+{
+  //
+  // PositionMapIterator prefix increment operator
+  // Moves to the next index which holds a value
+  //
+  // returns
+  // -------
+  // PositionMapIterator &
+  //  - the incremented iterator
+  //
+
+  this->idx=this->map->next(this->idx+1);
+  return *this;
+}
+
+template <typename T, INDEXING I>
+inline PositionMapIterator<T,I> PositionMapIterator<T,I>::operator++(int)
+{
+  //
+  // PositionMapIterator postfix increment operator
+  //
+  // returns
+  // -------
+  // PositionMapIterator
+  //  - the iterator before incrementing
+  //
+
+  PositionMapIterator tmp(*this);
+  ++(*this);
+  return tmp;
+}
+
+template <typename T, INDEXING I>
+inline bool PositionMap<T,I>::insert(const Board &board, const T &value)
+{
+  //
+  // Insert a value for a board, if it has none
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to insert the value for
+  // value : const T &
+  //  - the value to insert
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if the value was inserted, false if the board already had a value, which is left unchanged
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if the map is not indexed by rank, and the board cannot be reached in a game
+  //
+
+  const int index=this->checked_index(board);
+  if (this->has(index)) { return false; }
+  this->values[index]=value;
+  this->present[index/64]|=std::uint64_t{1}<<(index%64);
+  ++this->count;
+  return true;
+}
+
+template <typename T, INDEXING I>
+inline bool PositionMap<T,I>::erase(const Board &board)
+{
+  //
+  // Remove the value of a board
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to remove the value of
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if a value was removed, false if the board had no value
+  //
+
+  const int index=PositionMap::index(board);
+  if (index==-1||!this->has(index)) { return false; }
+  this->values[index]=T();
+  this->present[index/64]&=~(std::uint64_t{1}<<(index%64));
+  --this->count;
+  return true;
+}
+
+template <typename T, INDEXING I>
+inline void PositionMap<T,I>::clear(void)
+{
+  //
+  // Remove the values of all boards
+  //
+
+  std::fill(std::begin(this->values),std::end(this->values),T());
+  std::fill(std::begin(this->present),std::end(this->present),0);
+  this->count=0;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline bool PositionMap<T,I>::contains(const Board &board) const
+{
+  //
+  // Check if a board has a value
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to check
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if the board has a value, false otherwise
+  //
+
+  const int index=PositionMap::index(board);
+  return index!=-1&&this->has(index);
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline T *PositionMap<T,I>::find(const Board &board)
+{
+  //
+  // Find the value of a board
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to find the value of
+  //
+  // returns
+  // -------
+  // T *
+  //  - a pointer to the value of the board, or nullptr if it has none
+  //
+
+  const int index=PositionMap::index(board);
+  return index!=-1&&this->has(index) ? &this->values[index] : nullptr;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline const T *PositionMap<T,I>::find(const Board &board) const
+{
+  //
+  // Find the value of a board
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to find the value of
+  //
+  // returns
+  // -------
+  // const T *
+  //  - a pointer to the value of the board, or nullptr if it has none
+  //
+
+  const int index=PositionMap::index(board);
+  return index!=-1&&this->has(index) ? &this->values[index] : nullptr;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline T &PositionMap<T,I>::at(const Board &board)
+{
+  //
+  // Get the value of a board
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to get the value of
+  //
+  // returns
+  // -------
+  // T &
+  //  - the value of the board
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if the board has no value
+  //
+
+  T *value=this->find(board);
+  if (value==nullptr) { throw std::out_of_range("Board has no value in the map."); }
+  return *value;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline const T &PositionMap<T,I>::at(const Board &board) const
+{
+  //
+  // Get the value of a board
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to get the value of
+  //
+  // returns
+  // -------
+  // const T &
+  //  - the value of the board
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if the board has no value
+  //
+
+  const T *value=this->find(board);
+  if (value==nullptr) { throw std::out_of_range("Board has no value in the map."); }
+  return *value;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline T &PositionMap<T,I>::operator[](const Board &board)
+{
+  //
+  // PositionMap subscript operator
+  // Get the value of a board, inserting a default value if it has none
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to get the value of
+  //
+  // returns
+  // -------
+  // T &
+  //  - the value of the board
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if the map is not indexed by rank, and the board cannot be reached in a game
+  //
+
+  const int index=this->checked_index(board);
+  if (!this->has(index))
+  {
+    this->present[index/64]|=std::uint64_t{1}<<(index%64);
+    ++this->count;
+  }
+  return this->values[index];
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline int PositionMap<T,I>::index(const Board &board)
+{
+  //
+  // Get the index of a board in the map
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to index
+  //
+  // returns
+  // -------
+  // int
+  //  - the rank, legal index, or class index of the board, as the map is indexed, which is -1 if the map is not indexed by rank and
+  //    the board cannot be reached in a game
+  //
+
+  if constexpr (I==INDEXING::kRank) { return board.rank(); }
+  else if constexpr (I==INDEXING::kLegal) { return board.legal_index(); }
+  else { return board.class_index(); }
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline Board PositionMap<T,I>::board(const int index)
+{
+  //
+  // Get the board of an index in the map
+  // The inverse of PositionMap::index, up to an isometry if the map is indexed by class
+  //
+  // parameters
+  // ----------
+  // index : const int
+  //  - the index of the board, in [0,kSize)
+  //
+  // returns
+  // -------
+  // Board
+  //  - the board of the index
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if index is not in [0,kSize)
+  //
+
+  if constexpr (I==INDEXING::kRank) { return Board::from_rank(index); }
+  else if constexpr (I==INDEXING::kLegal) { return Board::from_legal_index(index); }
+  else { return Board::from_class_index(index); }
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline bool PositionMap<T,I>::has(const int index) const
+{
+  //
+  // Check if an index holds a value
+  //
+  // parameters
+  // ----------
+  // index : const int
+  //  - the index to check, in [0,kSize)
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if the index holds a value, false otherwise
+  //
+
+  return (this->present[index/64]>>(index%64))&1;
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline int PositionMap<T,I>::next(const int index) const
+{
+  //
+  // Find the first index which holds a value, starting from a given index
+  // Whole words of the bitset are skipped at a time
+  //
+  // parameters
+  // ----------
+  // index : const int
+  //  - the index to start from
+  //
+  // returns
+  // -------
+  // int
+  //  - the first index at or after index which holds a value, or kSize if there is none
+  //
+
+  if (index>=kSize) { return kSize; }
+  int word=index/64;
+  std::uint64_t bits=this->present[word]&(~std::uint64_t{0}<<(index%64));
+  while (bits==0)
+  {
+    if (++word==static_cast<int>(this->present.size())) { return kSize; }
+    bits=this->present[word];
+  }
+  return 64*word+countr_zero(bits);
+}
+
+template <typename T, INDEXING I>
+[[nodiscard]] inline int PositionMap<T,I>::checked_index(const Board &board) const
+{
+  //
+  // Get the index of a board in the map, which must have one
+  //
+  // parameters
+  // ----------
+  // board : const Board &
+  //  - the board to index
+  //
+  // returns
+  // -------
+  // int
+  //  - the index of the board
+  //
+  // throws
+  // ------
+  // std::out_of_range
+  //  - if the map is not indexed by rank, and the board cannot be reached in a game
+  //
+
+  const int index=PositionMap::index(board);
+  if (index==-1) { throw std::out_of_range("Board cannot be reached in a game."); }
+  return index;
+}
+
+// Inline Overloads
+template <typename T, INDEXING I>
+inline bool operator==(const PositionMapIterator<T,I> &lhs, const PositionMapIterator<T,I> &rhs)
+{
+  //
+  // PositionMapIterator operator==
+  // Compare two instances of PositionMapIterator
+  //
+  // parameters
+  // ----------
+  // lhs,rhs : const PositionMapIterator &
+  //  - the port and starboard sides of the equality
+  //
+  // returns
+  // -------
+  // bool
+  //  - true if they iterate over the same map and are at the same index, false otherwise
+  //
+
+  return lhs.map==rhs.map&&lhs.idx==rhs.idx;
+}
+
+template <typename T, INDEXING I>
+inline bool operator!=(const PositionMapIterator<T,I> &lhs, const PositionMapIterator<T,I> &rhs)
+{
+  //
+  // PositionMapIterator operator!=
+  // Compare two instances of PositionMapIterator
+  //
+  // parameters
+  // ----------
+  // lhs,rhs : const PositionMapIterator &
+  //  - the port and starboard sides of the inequality
+  //
+  // returns
+  // -------
+  // bool
+  //  - false if they iterate over the same map and are at the same index, true otherwise
+  //
+
+  return !(lhs==rhs);
+}
+} // namespace menace
+
+#endif // POSITIONMAP_H__
@@ -0,0 +1,169 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// threadpool.cpp                                                                                                                        //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Implementation of the thread pool for the parallel searches of MENACE, and of the token by which searches are stopped
+
+
+#include <threadpool.hpp>
+
+namespace menace
+{
+ThreadPool::ThreadPool(const int threads) : threads(), mutex(), started(), finished(), job(nullptr), jobs(0), running(0)
+  , stopping(false)
+{
+  //
+  // ThreadPool class constructor
+  // Starts threads-1 threads, which wait for jobs; the thread calling ThreadPool::run is the last
+  //
+  // parameters
+  // ----------
+  // threads : const int
+  //  - the number of threads to run each job on, including the calling thread
+  //
+  // throws
+  // ------
+  // std::invalid_argument
+  //  - if threads is less than 1
+  //
+
+  if (threads<1) { throw std::invalid_argument("A thread pool must have at least one thread."); }
+  this->threads.reserve(threads-1);
+  for (int itr=1;itr<threads;++itr) { this->threads.emplace_back(&ThreadPool::work,this,itr); }
+}
+
+ThreadPool::~ThreadPool()
+{
+  //
+  // ThreadPool class destructor
+  // Stops and joins every thread
+  //
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping=true;
+  }
+  this->started.notify_all();
+  for (std::thread &thread:this->threads) { thread.join(); }
+}
+
+void ThreadPool::run(const std::function<void(const int)> &job)
+{
+  //
+  // Run a job on every thread of the pool, and wait for all of them to finish
+  //
+  // parameters
+  // ----------
+  // job : const std::function<void(const int)> &
+  //  - the job to run, given the index of the thread running it, in [0,ThreadPool::size())
+  //
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->job=&job;
+    ++this->jobs;
+    this->running=static_cast<int>(this->threads.size());
+  }
+  this->started.notify_all();
+  job(0);
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->finished.wait(lock,[this]() { return this->running==0; });
+  this->job=nullptr;
+}
+
+[[nodiscard]] int ThreadPool::size(void) const
+{
+  //
+  // Get the number of threads of the pool
+  //
+  // returns
+  // -------
+  // int
+  //  - the number of threads each job is run on, including the calling thread
+  //
+
+  return static_cast<int>(this->threads.size())+1;
+}
+
+void ThreadPool::work(const int thread)
+{
+  //
+  // Run each job given to the pool, until the pool is stopped
+  //
+  // parameters
+  // ----------
+  // thread : const int
+  //  - the index of the thread, in [1,ThreadPool::size())
+  //
+
+  std::uint64_t done=0;
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->started.wait(lock,[this,done]() { return this->stopping||this->jobs!=done; });
+    if (this->stopping) { return; }
+    done=this->jobs;
+    const std::function<void(const int)> &job=*this->job;
+
+    lock.unlock();
+    job(thread);
+    lock.lock();
+    if (--this->running==0) { this->finished.notify_one(); }
+  }
+}
+
+StopToken::StopToken() : state(std::make_shared<std::atomic<STOP>>(STOP::kNone))
+{
+  //
+  // StopToken class constructor
+  // Copies of the token share its request, so one copy can be given to a search and another kept to stop it
+  //
+}
+
+void StopToken::request(const STOP stop) const
+{
+  //
+  // Ask the search holding the token to stop
+  // An abort replaces a request to return, but a request to return does not replace an abort
+  //
+  // parameters
+  // ----------
+  // stop : const STOP
+  //  - STOP::kReturn to stop and give the best found so far, or STOP::kAbort to stop and give nothing
+  //
+
+  if (stop==STOP::kAbort) { this->state->store(STOP::kAbort); }
+  else if (stop==STOP::kReturn)
+  {
+    STOP expected=STOP::kNone;
+    this->state->compare_exchange_strong(expected,STOP::kReturn);
+  }
+}
+
+void StopToken::reset(void) const
+{
+  //
+  // Withdraw any request, so the next search runs to its end
+  //
+
+  this->state->store(STOP::kNone);
+}
+
+[[nodiscard]] STOP StopToken::requested(void) const
+{
+  //
+  // Get the request made of the search holding the token
+  //
+  // returns
+  // -------
+  // STOP
+  //  - STOP::kNone if the search may run to its end, otherwise how it should stop
+  //
+
+  return this->state->load(std::memory_order_relaxed);
+}
+} // namespace menace
@@ -0,0 +1,75 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// threadpool.hpp                                                                                                                        //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Thread pool for the parallel searches of MENACE, and the token by which searches are stopped
+
+
+#pragma once
+
+#ifndef THREADPOOL_H__
+#define THREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <menace.hpp>
+
+namespace menace
+{
+// Classes
+// a fixed set of threads which each run a job given to the pool, the calling thread taking part as thread 0
+// the threads are started once, and wait for jobs between searches
+class ThreadPool
+{
+public:
+  explicit ThreadPool(const int threads);
+  ThreadPool(const ThreadPool &other)=delete;
+  ~ThreadPool();
+
+  ThreadPool &operator=(const ThreadPool &other)=delete;
+
+  void run(const std::function<void(const int)> &job);
+
+  [[nodiscard]] int size(void) const;
+
+private:
+  void work(const int thread);
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable started,finished;
+  // the job being run, and a count of the jobs given, so each thread runs each job once
+  const std::function<void(const int)> *job;
+  std::uint64_t jobs;
+  // the number of threads yet to finish the job
+  int running;
+  bool stopping;
+};
+
+// a request for a search to stop early, shared between every copy of the token, which may be made from any thread
+class StopToken
+{
+public:
+  StopToken();
+
+  void request(const STOP stop) const;
+  void reset(void) const;
+
+  [[nodiscard]] STOP requested(void) const;
+
+private:
+  std::shared_ptr<std::atomic<STOP>> state;
+};
+} // namespace menace
+
+#endif // THREADPOOL_H__
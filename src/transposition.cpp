@@ -0,0 +1,311 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// transposition.cpp                                                                                                                     //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Implementation of the transposition table of MENACE
+
+
+#include <transposition.hpp>
+
+namespace menace
+{
+static_assert(sizeof(TranspositionBucket)==64,"a bucket must fill exactly one cache line");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,"entries must be read and written without locks");
+
+TranspositionTable::TranspositionTable(const size_t bytes) : buckets(), bucket_count(1), generation(kEmptyGeneration+1)
+{
+  //
+  // TranspositionTable class constructor
+  // this->bucket_count is set to the largest power of two whose buckets fit in bytes, with at least one bucket
+  //
+  // parameters
+  // ----------
+  // bytes : const size_t
+  //  - the memory the table may use
+  //
+
+  while (2*this->bucket_count*sizeof(TranspositionBucket)<=bytes) { this->bucket_count*=2; }
+}
+
+[[nodiscard]] bool TranspositionTable::probe(const std::uint64_t key, int &alpha, int &beta, int &value)
+{
+  //
+  // Look up a board in the table, using whatever is stored for it however deep the search behind it
+  //
+  // parameters
+  // ----------
+  // key : const std::uint64_t
+  //  - the hash of the board's class of isometries, as given by BasicBoard::symmetric_hash
+  // alpha : int &
+  //  - the worst value the maximising player can be gauranteed, raised by a lower bound in the table
+  // beta : int &
+  //  - the worst value the minimising player can be gauranteed, lowered by an upper bound in the table
+  // value : int &
+  //  - set to the value of the board if it is settled
+  //
+  // returns
+  // -------
+  // bool
+  //  - if the value of the board is settled by the table
+  //
+
+  int move;
+  return this->probe(key,0,alpha,beta,value,move);
+}
+
+[[nodiscard]] bool TranspositionTable::probe(const std::uint64_t key, const int depth, int &alpha, int &beta, int &value, int &move)
+{
+  //
+  // Look up a board in the table
+  // An exact value, or a bound outside of the window [alpha,beta], settles the board's value
+  // A bound inside the window narrows it instead
+  // A board which is found is marked as used by the current search, so it is kept over older entries
+  // Only entries from a search at least as deep as the one asked for are used for the value, but the move of any entry is given
+  //
+  // parameters
+  // ----------
+  // key : const std::uint64_t
+  //  - the hash of the board's class of isometries, as given by BasicBoard::symmetric_hash
+  // depth : const int
+  //  - the number of moves the board is to be searched ahead
+  // alpha : int &
+  //  - the worst value the maximising player can be gauranteed, raised by a lower bound in the table
+  // beta : int &
+  //  - the worst value the minimising player can be gauranteed, lowered by an upper bound in the table
+  // value : int &
+  //  - set to the value of the board if it is settled
+  // move : int &
+  //  - set to the best move stored for the board, or kNoMove
+  //
+  // returns
+  // -------
+  // bool
+  //  - if the value of the board is settled by the table
+  //
+
+  move=kNoMove;
+  // nothing has been stored
+  if (!this->buckets) { return false; }
+
+  for (TranspositionEntry &entry:this->buckets[this->bucket_index(key)].entries)
+  {
+    // an entry being written by another thread does not match
+    const std::uint64_t packed=entry.data.load(std::memory_order_relaxed);
+    if ((entry.check.load(std::memory_order_relaxed)^packed)!=key) { continue; }
+    TranspositionData data=TranspositionData::unpack(packed);
+    if (data.generation==kEmptyGeneration) { continue; }
+    if (data.generation!=this->generation)
+    {
+      data.generation=this->generation;
+      entry.data.store(data.pack(),std::memory_order_relaxed);
+      entry.check.store(key^data.pack(),std::memory_order_relaxed);
+    }
+    move=data.move;
+    // the search behind the entry is too shallow to be relied on
+    if (data.depth<depth) { return false; }
+    value=data.value;
+    switch (data.bound)
+    {
+      case BOUND::kExact:
+        return true;
+      case BOUND::kLower:
+        alpha=std::max(alpha,value);
+        break;
+      case BOUND::kUpper:
+        beta=std::min(beta,value);
+        break;
+    }
+    return alpha>=beta;
+  }
+  // board has not been stored
+  return false;
+}
+
+void TranspositionTable::store(const std::uint64_t key, const int value, const BOUND bound, const int depth, const int move)
+{
+  //
+  // Store what a search found of the value of a board
+  // Anything already stored for the board is replaced, otherwise an empty entry of its bucket is used
+  // In a full bucket, the entry whose depth less its weighted age is smallest is replaced, so entries from old searches age out
+  //
+  // parameters
+  // ----------
+  // key : const std::uint64_t
+  //  - the hash of the board's class of isometries, as given by BasicBoard::symmetric_hash
+  // value : const int
+  //  - the value found for the board
+  // bound : const BOUND
+  //  - if value is the value of the board, or a lower or upper bound on it
+  // depth : const int
+  //  - the number of moves the board was searched ahead, the number of its empty positions if it was searched to the end
+  // move : const int
+  //  - the best move found for the board, on the board of its class whose hash is key, or kNoMove to keep any stored
+  //
+
+  if (!this->buckets) { this->buckets.reset(new TranspositionBucket[this->bucket_count]()); }
+
+  TranspositionBucket &bucket=this->buckets[this->bucket_index(key)];
+  TranspositionEntry *replace=nullptr;
+  int worst=std::numeric_limits<int>::max(),best=move;
+  for (TranspositionEntry &entry:bucket.entries)
+  {
+    const std::uint64_t packed=entry.data.load(std::memory_order_relaxed);
+    const TranspositionData data=TranspositionData::unpack(packed);
+    if (data.generation==kEmptyGeneration) { replace=&entry; break; }
+    if ((entry.check.load(std::memory_order_relaxed)^packed)==key)
+    {
+      replace=&entry;
+      if (best==kNoMove) { best=data.move; }
+      break;
+    }
+    if (const int score=data.depth-kAgeWeight*this->age(data);score<worst)
+    {
+      replace=&entry;
+      worst=score;
+    }
+  }
+  // the data is written first, so a thread reading between the writes finds a mismatched key rather than the wrong data
+  const std::uint64_t packed=TranspositionData{static_cast<std::int8_t>(value),bound,static_cast<std::uint8_t>(depth),this->generation
+    ,static_cast<std::int8_t>(best)}.pack();
+  replace->data.store(packed,std::memory_order_relaxed);
+  replace->check.store(key^packed,std::memory_order_relaxed);
+}
+
+void TranspositionTable::new_search(void)
+{
+  //
+  // Start a new generation of entries, so the entries of earlier searches are replaced first
+  // The generation skips kEmptyGeneration when it wraps
+  // The buckets are allocated here if they have not been, so threads of a search never allocate them; no search may be running
+  //
+
+  if (!this->buckets) { this->buckets.reset(new TranspositionBucket[this->bucket_count]()); }
+  this->generation=this->generation==std::numeric_limits<std::uint8_t>::max() ? kEmptyGeneration+1 : this->generation+1;
+}
+
+void TranspositionTable::clear(void)
+{
+  //
+  // Remove every board from the table, and release its memory until it is next stored to
+  // No search may be running
+  //
+
+  this->buckets.reset();
+  this->generation=kEmptyGeneration+1;
+}
+
+[[nodiscard]] size_t TranspositionTable::size(void) const
+{
+  //
+  // Get the number of boards in the table
+  //
+  // returns
+  // -------
+  // size_t
+  //  - the number of boards stored
+  //
+
+  if (!this->buckets) { return 0; }
+
+  size_t count=0;
+  for (size_t itr=0;itr<this->bucket_count;++itr)
+  {
+    const std::array<TranspositionEntry,4> &entries=this->buckets[itr].entries;
+    count+=std::count_if(std::cbegin(entries),std::cend(entries),[](const TranspositionEntry &entry)
+      { return TranspositionData::unpack(entry.data.load(std::memory_order_relaxed)).generation!=kEmptyGeneration; });
+  }
+  return count;
+}
+
+[[nodiscard]] size_t TranspositionTable::capacity(void) const
+{
+  //
+  // Get the number of boards the table can hold
+  //
+  // returns
+  // -------
+  // size_t
+  //  - the number of entries in all buckets
+  //
+
+  return this->bucket_count*std::tuple_size<decltype(TranspositionBucket::entries)>::value;
+}
+
+[[nodiscard]] size_t TranspositionTable::bucket_index(const std::uint64_t key) const
+{
+  //
+  // Get the index of the bucket a key belongs to, given by the lowest bits of the key
+  //
+  // parameters
+  // ----------
+  // key : const std::uint64_t
+  //  - the hash of the board's class of isometries
+  //
+  // returns
+  // -------
+  // size_t
+  //  - the index of the bucket which holds the key, if it is stored
+  //
+
+  return static_cast<size_t>(key)&(this->bucket_count-1);
+}
+
+[[nodiscard]] int TranspositionTable::age(const TranspositionData &data) const
+{
+  //
+  // Get the number of searches since an entry was last stored or found
+  // Generations wrap around, skipping kEmptyGeneration
+  //
+  // parameters
+  // ----------
+  // data : const TranspositionData &
+  //  - the data of a non-empty entry
+  //
+  // returns
+  // -------
+  // int
+  //  - the age of the entry, 0 if it is from the current search
+  //
+
+  constexpr int kGenerations=std::numeric_limits<std::uint8_t>::max();
+  return (this->generation-data.generation+kGenerations)%kGenerations;
+}
+
+[[nodiscard]] TranspositionData TranspositionData::unpack(const std::uint64_t data)
+{
+  //
+  // Get what is known of a board from its packed form
+  //
+  // parameters
+  // ----------
+  // data : const std::uint64_t
+  //  - the packed data, as given by TranspositionData::pack
+  //
+  // returns
+  // -------
+  // TranspositionData
+  //  - the data, one field to each of the lowest five bytes
+  //
+
+  return TranspositionData{static_cast<std::int8_t>(data&0xff),static_cast<BOUND>(data>>8&0xff),static_cast<std::uint8_t>(data>>16&0xff)
+    ,static_cast<std::uint8_t>(data>>24&0xff),static_cast<std::int8_t>(data>>32&0xff)};
+}
+
+[[nodiscard]] std::uint64_t TranspositionData::pack(void) const
+{
+  //
+  // Pack what is known of a board into a single word
+  //
+  // returns
+  // -------
+  // std::uint64_t
+  //  - the data, one field to each of the lowest five bytes, so an empty entry of zeros has kEmptyGeneration
+  //
+
+  return std::uint64_t{static_cast<std::uint8_t>(this->value)}|std::uint64_t{static_cast<std::uint8_t>(this->bound)}<<8
+    |std::uint64_t{this->depth}<<16|std::uint64_t{this->generation}<<24|std::uint64_t{static_cast<std::uint8_t>(this->move)}<<32;
+}
+} // namespace menace
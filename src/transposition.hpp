@@ -0,0 +1,98 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// transposition.hpp                                                                                                                     //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Transposition table of MENACE
+
+
+#pragma once
+
+#ifndef TRANSPOSITION_H__
+#define TRANSPOSITION_H__
+
+#include <atomic>
+#include <memory>
+
+#include <menace.hpp>
+
+namespace menace
+{
+// Classes
+// what is known of the value of a board, packed into a single word to be stored atomically
+class TranspositionData
+{
+public:
+  [[nodiscard]] static TranspositionData unpack(const std::uint64_t data);
+  [[nodiscard]] std::uint64_t pack(void) const;
+
+  // the value found for the board
+  std::int8_t value;
+  // if value is the value of the board, or only a bound on it from a search cut off by alpha-beta pruning
+  BOUND bound;
+  // the number of empty positions of the board, which bounds the size of the search behind value
+  std::uint8_t depth;
+  // the search which last stored or found the board, or TranspositionTable::kEmptyGeneration if nothing is stored
+  std::uint8_t generation;
+  // the best move found for the board, on the board of its class whose hash is the key, or TranspositionTable::kNoMove
+  std::int8_t move;
+};
+
+// a board in the table, read and written by any number of threads at once without locks
+// the key is kept xored with the data, so an entry torn by two threads writing it at once matches neither of their keys
+class TranspositionEntry
+{
+public:
+  // the hash of the board's class of isometries, xored with data
+  std::atomic<std::uint64_t> check;
+  // the packed TranspositionData of the board
+  std::atomic<std::uint64_t> data;
+};
+
+// the entries whose keys share their lowest bits, filling a cache line
+class alignas(64) TranspositionBucket
+{
+public:
+  std::array<TranspositionEntry,4> entries;
+};
+
+// maps the hash of a board's class of isometries to what is known of its value, in a fixed amount of memory
+// probes and stores may be made from several threads at once and never block, as each entry is checked against its key when read
+// when a bucket is full, entries from older searches are replaced first, and among those of one search the shallowest
+class TranspositionTable
+{
+public:
+  // the memory used by a table unless it is given otherwise
+  static constexpr size_t kDefaultBytes=size_t{1}<<20;
+  // the generation of an entry which holds nothing
+  static constexpr std::uint8_t kEmptyGeneration=0;
+  // the move of an entry which has none
+  static constexpr int kNoMove=-1;
+
+  explicit TranspositionTable(const size_t bytes=kDefaultBytes);
+
+  [[nodiscard]] bool probe(const std::uint64_t key, int &alpha, int &beta, int &value);
+  [[nodiscard]] bool probe(const std::uint64_t key, const int depth, int &alpha, int &beta, int &value, int &move);
+  void store(const std::uint64_t key, const int value, const BOUND bound, const int depth, const int move=kNoMove);
+  void new_search(void);
+  void clear(void);
+
+  [[nodiscard]] size_t size(void) const;
+  [[nodiscard]] size_t capacity(void) const;
+
+private:
+  // how many positions of depth a search of age outweighs in replacement
+  static constexpr int kAgeWeight=8;
+  [[nodiscard]] size_t bucket_index(const std::uint64_t key) const;
+  [[nodiscard]] int age(const TranspositionData &data) const;
+
+  // the buckets are allocated on first use, so a table which is never searched with costs nothing
+  std::unique_ptr<TranspositionBucket[]> buckets;
+  size_t bucket_count;
+  std::uint8_t generation;
+};
+} // namespace menace
+
+#endif // TRANSPOSITION_H__
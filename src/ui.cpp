@@ -16,7 +16,8 @@ namespace menace
 // save a global handle for console manipulation
 const WINDOWS::HANDLE UI::std_handle=WINDOWS::GetStdHandle(STD_OUTPUT_HANDLE);
 // no positions begin as advisial
-std::array<bool,9> UI::advisial{{false,false,false,false,false,false,false,false,false}};
+std::array<std::optional<COLOUR>,9> UI::advisial{};
+VALUE UI::advised=VALUE::kEmpty;
 
 UI::UI(const Board *display_board) : display_board(display_board)
 {
@@ -746,27 +747,37 @@ std::string UI::colour_text(const std::string &str, const COLOUR col)
   return kColours.at(col)+str+kColourEnd;
 }
 
-void UI::set_advisial(const POSITION pos)
+void UI::set_advisial(const std::vector<MoveEvaluation> &evaluation, const VALUE val)
 {
   //
-  // Mark a given position as an advisial move not an actual move
+  // Mark each move of an evaluation as an advisial move not an actual move, coloured as a heatmap of its value: green for the best
+  // moves, yellow for worse moves which do not lose, and red for moves which lose
   //
   // parameters
   // ----------
-  // pos : const POSITION
-  //  - the position to mark
+  // evaluation : const std::vector<MoveEvaluation> &
+  //  - the moves to mark, as given by BasicMENACE::evaluate_moves, best first
+  // val : const VALUE
+  //  - the value of the side advised, shown in each position marked
   //
 
-  UI::advisial[static_cast<int>(pos)]=true;
+  UI::advised=val;
+  for (const MoveEvaluation &move:evaluation)
+  {
+    COLOUR col=COLOUR::kYellow;
+    if (move.value==evaluation.front().value) { col=COLOUR::kGreen; }
+    else if (move.value==-MENACE::kWin) { col=COLOUR::kRed; }
+    UI::advisial[static_cast<int>(move.pos)]=col;
+  }
 }
 
 void UI::reset_advisial(void)
 {
   //
-  // Reset UI::advisial to all false
+  // Reset UI::advisial to mark no positions
   //
 
-  std::fill(std::begin(UI::advisial),std::end(UI::advisial),false);
+  std::fill(std::begin(UI::advisial),std::end(UI::advisial),std::nullopt);
 }
 
 std::ostream &operator<<(std::ostream &os, const Board &board)
@@ -800,7 +811,12 @@ std::ostream &operator<<(std::ostream &os, const Board &board)
     std::string disp=kValueStrings.at(val);
     COLOUR col=kValueColours.at(val);
 
-    if (UI::advisial[itr.ind]) { col=COLOUR::kGreen; }
+    // a position advised on shows the move which would be made there
+    if (UI::advisial[itr.ind])
+    {
+      disp=kValueStrings.at(UI::advised);
+      col=*UI::advisial[itr.ind];
+    }
 
     os << UI::colour_text(disp,col);
     if (itr.pos%3!=2) // end of column
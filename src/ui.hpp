@@ -17,6 +17,8 @@
 
 #include <iomanip>
 #include <iostream>
+#include <optional>
+#include <vector>
 
 namespace WINDOWS
 {
@@ -31,6 +33,7 @@ namespace WINDOWS
 #include <boost/algorithm/string.hpp>
 
 #include <board.hpp>
+#include <player.hpp>
 
 namespace menace
 {
@@ -126,7 +129,7 @@ public:
   void clear(void);
   [[nodiscard]] WINDOWS::COORD origin(void);
 
-  void set_advisial(const POSITION pos);
+  void set_advisial(const std::vector<MoveEvaluation> &evaluation, const VALUE val);
   void reset_advisial(void);
 
   friend std::ostream &operator<<(std::ostream &os, const Board &board);
@@ -140,7 +143,9 @@ private:
   std::string blank(const int n);
   static const WINDOWS::HANDLE std_handle;
 
-  static std::array<bool,9> advisial;
+  // the colour of each move advised on, in the heatmap of the advice, and the value of the side advised
+  static std::array<std::optional<COLOUR>,9> advisial;
+  static VALUE advised;
 };
 } // namespace menace
 
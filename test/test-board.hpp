@@ -10,6 +10,9 @@
 
 
 #include <array>
+#include <functional>
+#include <set>
+
 #include <board.hpp>
 
 namespace BoardTesting
@@ -189,6 +192,200 @@ BOOST_AUTO_TEST_SUITE(test_board)
     }
   }
 
+  // test assigning positions without exceptions
+  BOOST_AUTO_TEST_CASE(try_assign)
+  {
+    // check every failure is reported in the same order assign_position throws
+    Board board;
+    BOOST_CHECK(board.try_assign(POSITION::kTopLeft,VALUE::kEmpty)==ASSIGNMENT::kEmptyValue);
+    BOOST_CHECK(board.try_assign(static_cast<POSITION>(-1),VALUE::kEmpty)==ASSIGNMENT::kEmptyValue);
+    BOOST_CHECK(board.try_assign(static_cast<POSITION>(-1),VALUE::kCross)==ASSIGNMENT::kOutOfRange);
+    BOOST_CHECK(board.try_assign(static_cast<POSITION>(9),VALUE::kCross)==ASSIGNMENT::kOutOfRange);
+    BOOST_CHECK(board.get_plays()==ITERATION::kZero);
+
+    // check a valid assignment is made, and cannot be made again
+    BOOST_CHECK(board.try_assign(POSITION::kTopLeft,VALUE::kCross)==ASSIGNMENT::kAssigned);
+    BOOST_CHECK(board[POSITION::kTopLeft]==VALUE::kCross);
+    BOOST_CHECK(board.get_value(POSITION::kTopLeft)==VALUE::kCross);
+    BOOST_CHECK(board.try_assign(POSITION::kTopLeft,VALUE::kNought)==ASSIGNMENT::kNonEmptyPosition);
+    BOOST_CHECK(board.get_plays()==ITERATION::kOne);
+
+    // check a finished game is reported
+    for (const POSITION pos:{POSITION::kMiddleLeft,POSITION::kTopMiddle,POSITION::kMiddleMiddle,POSITION::kTopRight})
+    {
+      BOOST_CHECK(board.try_assign(pos,board.get_plays()%2==0 ? VALUE::kCross : VALUE::kNought)==ASSIGNMENT::kAssigned);
+    }
+    BOOST_CHECK(board.check_board()==RESULT::kCross);
+    BOOST_CHECK(board.try_assign(POSITION::kBottomRight,VALUE::kNought)==ASSIGNMENT::kGameFinished);
+    BOOST_CHECK(board.get_value(POSITION::kBottomRight)==VALUE::kEmpty);
+
+    // check unchecked moves match checked moves
+    Board checked,unchecked;
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      checked.make_move(pos,draw_one.at(static_cast<int>(pos)));
+      unchecked.make_move_unchecked(pos,draw_one.at(static_cast<int>(pos)));
+      BOOST_CHECK(unchecked.get_mask(VALUE::kCross)==checked.get_mask(VALUE::kCross));
+      BOOST_CHECK(unchecked.get_mask(VALUE::kNought)==checked.get_mask(VALUE::kNought));
+      BOOST_CHECK(unchecked.get_plays()==checked.get_plays());
+      BOOST_CHECK(unchecked.check_board()==checked.check_board());
+      BOOST_CHECK(unchecked.hash()==checked.hash());
+    }
+    for (POSITION pos=POSITION::kBottomRight;pos>-1;pos=pos-1)
+    {
+      checked.unmake_move(pos);
+      unchecked.unmake_move_unchecked(pos,draw_one.at(static_cast<int>(pos)));
+      BOOST_CHECK(unchecked.get_mask(VALUE::kCross)==checked.get_mask(VALUE::kCross));
+      BOOST_CHECK(unchecked.get_mask(VALUE::kNought)==checked.get_mask(VALUE::kNought));
+      BOOST_CHECK(unchecked.check_board()==checked.check_board());
+      BOOST_CHECK(unchecked.hash()==checked.hash());
+    }
+    BOOST_CHECK(unchecked.get_plays()==ITERATION::kZero);
+  }
+
+  // test the masks of each side
+  BOOST_AUTO_TEST_CASE(masks)
+  {
+    Board board;
+    // check an empty board has every position empty
+    BOOST_CHECK(board.get_mask(VALUE::kCross)==0);
+    BOOST_CHECK(board.get_mask(VALUE::kNought)==0);
+    BOOST_CHECK(board.get_empty()==kFullBoard);
+    BOOST_CHECK(board.get_mask(VALUE::kEmpty)==kFullBoard);
+
+    // hard code a drawn board, checking the masks after every move
+    board_mask crosses=0,noughts=0;
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      const VALUE val=draw_one.at(static_cast<int>(pos));
+      board.assign_position(pos,val);
+      (val==VALUE::kCross ? crosses : noughts)|=position_mask(pos);
+      BOOST_CHECK(board.get_mask(VALUE::kCross)==crosses);
+      BOOST_CHECK(board.get_mask(VALUE::kNought)==noughts);
+      BOOST_CHECK(board.get_empty()==(~(crosses|noughts)&kFullBoard));
+    }
+    // check no position is empty
+    BOOST_CHECK(board.get_empty()==0);
+
+    // check the masks of the winning combinations
+    for (size_t itr=0;itr<kWinningPositions.size();++itr)
+    {
+      board_mask mask=0;
+      for (const POSITION pos:kWinningPositions[itr]) { mask|=position_mask(pos); }
+      BOOST_CHECK(kWinningMasks.at(itr)==mask);
+    }
+  }
+
+  // test the result is tracked as positions are assigned
+  BOOST_AUTO_TEST_CASE(results)
+  {
+    // check a drawn board is only a draw once the last position is played
+    Board board;
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      BOOST_CHECK(board.check_board()==RESULT::kNotWon);
+      board.assign_position(pos,draw_one.at(static_cast<int>(pos)));
+    }
+    BOOST_CHECK(board.check_board()==RESULT::kDraw);
+
+    // check every winning combination is found for both sides, with the other side playing the empty positions in order
+    for (VALUE val=VALUE::kCross;val<=VALUE::kNought;++val)
+    {
+      const VALUE other=val==VALUE::kCross ? VALUE::kNought : VALUE::kCross;
+      for (const board_mask mask:kWinningMasks)
+      {
+        Board won;
+        for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+        {
+          if (!(mask&position_mask(pos))) { continue; }
+          // play one of the other side's positions before each of the winner's, without letting the other side win
+          POSITION free=POSITION::kTopLeft;
+          while (mask&position_mask(free)||won[free]!=VALUE::kEmpty||std::any_of(std::cbegin(kWinningMasks),std::cend(kWinningMasks)
+            ,[&](const board_mask line){ return ((won.get_mask(other)|position_mask(free))&line)==line; })) { ++free; }
+          won.assign_position(free,other);
+          BOOST_CHECK(won.check_board()==RESULT::kNotWon);
+          won.assign_position(pos,val);
+        }
+        BOOST_CHECK(won.check_board()==static_cast<RESULT>(val));
+        // check isometries keep the result
+        BOOST_CHECK((won<<1).check_board()==static_cast<RESULT>(val));
+        BOOST_CHECK((won>>1).check_board()==static_cast<RESULT>(val));
+      }
+    }
+
+    // check the result is found after isometries have been applied mid-game
+    Board rotated;
+    rotated.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    rotated.assign_position(POSITION::kMiddleLeft,VALUE::kNought);
+    rotated.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    rotated.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    rotated=(rotated<<1)>>1;
+    // the top row is now the bottom of the right column
+    rotated.assign_position(POSITION::kBottomLeft,VALUE::kCross);
+    BOOST_CHECK(rotated.check_board()==RESULT::kNotWon);
+    rotated.assign_position(POSITION::kTopRight,VALUE::kCross);
+    BOOST_CHECK(rotated.check_board()==RESULT::kCross);
+
+    // check clearing resets the result
+    rotated.clear_board();
+    BOOST_CHECK(rotated.check_board()==RESULT::kNotWon);
+  }
+
+  // test moves can be made and unmade
+  BOOST_AUTO_TEST_CASE(make_and_unmake)
+  {
+    // check unmaking an empty position throws
+    Board board;
+    BOOST_CHECK_THROW(board.unmake_move(POSITION::kMiddleMiddle),unmaking_empty_position);
+    try
+    {
+      board.unmake_move(POSITION::kMiddleMiddle);
+    }
+    catch (const unmaking_empty_position &err)
+    {
+      BOOST_CHECK(err.pos==POSITION::kMiddleMiddle);
+    }
+
+    // play the drawn board, unmaking and remaking every move and checking the board is restored each time
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      const board_mask crosses=board.get_mask(VALUE::kCross),noughts=board.get_mask(VALUE::kNought);
+      const ITERATION plays=board.get_plays();
+      const RESULT result=board.check_board();
+
+      BOOST_CHECK_NO_THROW(board.make_move(pos,draw_one.at(static_cast<int>(pos))));
+      BOOST_CHECK(board[pos]==draw_one.at(static_cast<int>(pos)));
+      BOOST_CHECK_NO_THROW(board.unmake_move(pos));
+      BOOST_CHECK(board[pos]==VALUE::kEmpty);
+      BOOST_CHECK(board.get_mask(VALUE::kCross)==crosses);
+      BOOST_CHECK(board.get_mask(VALUE::kNought)==noughts);
+      BOOST_CHECK(board.get_plays()==plays);
+      BOOST_CHECK(board.check_board()==result);
+
+      board.make_move(pos,draw_one.at(static_cast<int>(pos)));
+    }
+    BOOST_CHECK(board.check_board()==RESULT::kDraw);
+    // check unmaking the last move of a draw leaves the game unfinished
+    board.unmake_move(POSITION::kBottomRight);
+    BOOST_CHECK(board.check_board()==RESULT::kNotWon);
+    board.make_move(POSITION::kBottomRight,VALUE::kNought);
+    BOOST_CHECK(board.check_board()==RESULT::kDraw);
+
+    // check unmaking a winning move leaves the game unfinished, and remaking it wins again
+    Board won;
+    for (const POSITION pos:{POSITION::kTopLeft,POSITION::kMiddleLeft,POSITION::kTopMiddle,POSITION::kMiddleMiddle})
+    {
+      won.make_move(pos,won.get_plays()%2==0 ? VALUE::kCross : VALUE::kNought);
+    }
+    won.make_move(POSITION::kTopRight,VALUE::kCross);
+    BOOST_CHECK(won.check_board()==RESULT::kCross);
+    BOOST_CHECK_THROW(won.make_move(POSITION::kMiddleRight,VALUE::kNought),game_finished);
+    won.unmake_move(POSITION::kTopRight);
+    BOOST_CHECK(won.check_board()==RESULT::kNotWon);
+    BOOST_CHECK_NO_THROW(won.make_move(POSITION::kMiddleRight,VALUE::kNought));
+    BOOST_CHECK(won.check_board()==RESULT::kNought);
+  }
+
   // test assignment operator
   BOOST_AUTO_TEST_CASE(assignment)
   {
@@ -349,6 +546,43 @@ BOOST_AUTO_TEST_SUITE(test_board)
     }
   }
 
+  // test iterating over masks and listing moves
+  BOOST_AUTO_TEST_CASE(move_list)
+  {
+    // check an empty mask has nothing to iterate over
+    BOOST_CHECK(MaskRange(0).begin()==MaskRange(0).end());
+    BOOST_CHECK(MoveList<9>(0).empty());
+
+    // check every position of the empty board is listed in order
+    Board board;
+    POSITION expected=POSITION::kTopLeft;
+    for (const POSITION pos:board.empty_positions()) { BOOST_CHECK(pos==expected++); }
+    BOOST_CHECK(expected==9);
+    const MoveList<9> all(board.get_empty());
+    BOOST_CHECK(all.size()==9);
+    for (size_t itr=0;itr<all.size();++itr) { BOOST_CHECK(all[itr]==static_cast<POSITION>(itr)); }
+
+    // check only the empty positions are listed as the board fills
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    board.assign_position(POSITION::kBottomRight,VALUE::kCross);
+    const MoveList<9> moves(board.get_empty());
+    BOOST_CHECK(moves.size()==6);
+    BOOST_CHECK(moves.front()==POSITION::kTopMiddle);
+    for (const POSITION pos:moves) { BOOST_CHECK(board[pos]==VALUE::kEmpty); }
+    BOOST_CHECK(std::find(std::begin(moves),std::end(moves),POSITION::kMiddleMiddle)==std::end(moves));
+
+    // check pushing and clearing
+    MoveList<9> list;
+    list.push_back(POSITION::kBottomLeft);
+    list.push_back(POSITION::kTopRight);
+    BOOST_CHECK(list.size()==2);
+    BOOST_CHECK(list[0]==POSITION::kBottomLeft);
+    BOOST_CHECK(list[1]==POSITION::kTopRight);
+    list.clear();
+    BOOST_CHECK(list.empty());
+  }
+
   // test board isometries (<< and >> are implemented in terms of <<= and >>=)
   BOOST_AUTO_TEST_CASE(isometries)
   {
@@ -380,6 +614,205 @@ BOOST_AUTO_TEST_SUITE(test_board)
     BOOST_CHECK(board.at(POSITION::kBottomRight)==VALUE::kCross);
   }
 
+  // test boards of other sizes
+  BOOST_AUTO_TEST_CASE(generic_boards)
+  {
+    // check the winning combinations are generated for each size
+    static_assert(std::is_same<Board::mask_type,board_mask>::value&&Board::kLines==8);
+    static_assert(BasicBoard<4,4,3>::kLines==24&&BasicBoard<5,5,4>::kLines==28&&BasicBoard<7,7,5>::kLines==60);
+    static_assert(std::is_same<BasicBoard<7,7,5>::mask_type,std::uint64_t>::value);
+    for (const std::array<POSITION,5> &line:BasicBoard<7,7,5>::kWinningPositions)
+    {
+      // each combination is five positions one step apart in one direction
+      const int step=static_cast<int>(line[1])-static_cast<int>(line[0]);
+      BOOST_CHECK(step==1||step==7||step==8||step==-6);
+      for (size_t itr=1;itr<line.size();++itr) { BOOST_CHECK(static_cast<int>(line[itr])-static_cast<int>(line[itr-1])==step); }
+    }
+
+    // check a diagonal wins only once it is complete
+    BasicBoard<5,5,4> board;
+    const std::array<int,7> moves={0,1,6,2,12,3,18};
+    for (size_t itr=0;itr<moves.size();++itr)
+    {
+      BOOST_CHECK(board.check_board()==RESULT::kNotWon);
+      board.assign_position(static_cast<POSITION>(moves[itr]),itr%2==0 ? VALUE::kCross : VALUE::kNought);
+    }
+    BOOST_CHECK(board.check_board()==RESULT::kCross);
+    BOOST_CHECK_THROW(board.assign_position(static_cast<POSITION>(24),VALUE::kNought),game_finished);
+    BOOST_CHECK_THROW(board.assign_position(static_cast<POSITION>(25),VALUE::kNought),std::out_of_range);
+    board.unmake_move(static_cast<POSITION>(18));
+    BOOST_CHECK(board.check_board()==RESULT::kNotWon);
+
+    // check the board can be iterated over, and matches its isometries
+    int count=0;
+    for (const BoardElement &elem:board) { BOOST_CHECK(static_cast<int>(elem.pos)==count++); }
+    BOOST_CHECK(count==25);
+    // check postfix increment gives the iterator as it was, on a board other than 3x3
+    BasicBoardIterator<5,5,4> itr=board.begin();
+    const BasicBoardIterator<5,5,4> jtr=itr++;
+    BOOST_CHECK(jtr->ind==0);
+    BOOST_CHECK(jtr->val==VALUE::kCross);
+    BOOST_CHECK(itr->ind==1);
+    BOOST_CHECK(itr->val==VALUE::kNought);
+    for (int itr=0;itr<4;++itr)
+    {
+      BOOST_CHECK((board<<itr)==board);
+      BOOST_CHECK(((board>>1)<<itr).symmetric_hash()==board.symmetric_hash());
+    }
+
+    // check a board which is not square has four isometries, and cannot be turned by a quarter
+    BasicBoard<3,4,3> wide;
+    static_assert(BasicBoard<3,4,3>::kIsometries==4);
+    wide.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    BOOST_CHECK((wide<<2).get_mask(VALUE::kCross)==1<<11);
+    BOOST_CHECK((wide>>1).get_mask(VALUE::kCross)==1<<3);
+    BOOST_CHECK(((wide>>1)<<2)==wide);
+    BOOST_CHECK_THROW(wide<<1,std::invalid_argument);
+
+    // check a full board with no winning combination is a draw
+    BasicBoard<4,4,3> full;
+    // XXOO
+    // OOXX
+    // XXOO
+    // OOXX
+    for (int itr=0;itr<16;++itr)
+    {
+      full.make_move_unchecked(static_cast<POSITION>(itr),(itr/2+itr/4)%2==0 ? VALUE::kCross : VALUE::kNought);
+    }
+    BOOST_CHECK(full.check_board()==RESULT::kDraw);
+    BOOST_CHECK(full.get_empty()==0);
+  }
+
+  // test finding the moves which are distinct up to an isometry
+  BOOST_AUTO_TEST_CASE(distinct_moves)
+  {
+    // check the empty board is left unchanged by every isometry, and has three distinct moves: a corner, an edge, and the centre
+    Board board;
+    BOOST_CHECK(board.get_symmetries()==0xff);
+    BOOST_CHECK(board.get_distinct_empty()==(position_mask(POSITION::kTopLeft)|position_mask(POSITION::kTopMiddle)
+      |position_mask(POSITION::kMiddleMiddle)));
+
+    // check a corner leaves only the reflection in its diagonal, which pairs the other positions off either side of it
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    BOOST_CHECK(popcount(board.get_symmetries())==2);
+    BOOST_CHECK(board.get_distinct_empty()==(position_mask(POSITION::kTopMiddle)|position_mask(POSITION::kTopRight)
+      |position_mask(POSITION::kMiddleMiddle)|position_mask(POSITION::kMiddleRight)|position_mask(POSITION::kBottomRight)));
+
+    // check a board with no symmetry has every empty position distinct
+    board.assign_position(POSITION::kTopMiddle,VALUE::kNought);
+    BOOST_CHECK(board.get_symmetries()==1);
+    BOOST_CHECK(board.get_distinct_empty()==board.get_empty());
+
+    // check every empty position is some isometry of a distinct one on every legal board
+    for (int index=0;index<kLegalPositions;++index)
+    {
+      const Board legal=Board::from_legal_index(index);
+      const board_mask distinct=legal.get_distinct_empty();
+      BOOST_CHECK((distinct&legal.get_empty())==distinct);
+      board_mask covered=0;
+      for (POSITION pos:MaskRange(distinct))
+      {
+        for (int itr=0;itr<kIsometries;++itr)
+        {
+          if (legal.get_symmetries()>>itr&1) { covered|=position_mask(apply_isometry(pos,itr)); }
+        }
+      }
+      BOOST_CHECK(covered==legal.get_empty());
+    }
+
+    // check larger and non-square boards
+    BOOST_CHECK(popcount(BasicBoard<4,4,3>().get_distinct_empty())==3);
+    BOOST_CHECK(popcount(BasicBoard<5,5,4>().get_distinct_empty())==6);
+    BOOST_CHECK(popcount(BasicBoard<3,4,3>().get_distinct_empty())==4);
+  }
+
+  // test scoring the lines of each side
+  BOOST_AUTO_TEST_CASE(line_score)
+  {
+    Board board;
+    // check the empty board favours neither side
+    BOOST_CHECK(board.get_line_score(VALUE::kCross)==0);
+    // check the centre lies on four lines, and a corner on three
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kCross);
+    BOOST_CHECK(board.get_line_score(VALUE::kCross)==4);
+    BOOST_CHECK(board.get_line_score(VALUE::kNought)==-4);
+    board.assign_position(POSITION::kTopLeft,VALUE::kNought);
+    BOOST_CHECK(board.get_line_score(VALUE::kCross)==3-2);
+    // check a line nearer completion counts for more, and a line held by both sides for neither
+    board.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    BOOST_CHECK(board.get_line_score(VALUE::kCross)==1+4+1-1);
+
+    // check the score is defined on larger boards
+    BasicBoard<7,7,5> large;
+    large.assign_position(static_cast<POSITION>(24),VALUE::kNought);
+    BOOST_CHECK(large.get_line_score(VALUE::kNought)>0);
+    BOOST_CHECK(large.get_line_score(VALUE::kCross)==-large.get_line_score(VALUE::kNought));
+  }
+
+  // test finding the moves which win immediately, or must be blocked
+  BOOST_AUTO_TEST_CASE(threats)
+  {
+    Board board;
+    // check there are no threats on an empty board
+    BOOST_CHECK(board.get_winning_moves(VALUE::kCross)==0);
+    BOOST_CHECK(board.get_blocking_moves(VALUE::kNought)==0);
+
+    // X X .
+    // . O .
+    // . . .
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    board.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    // check cross threatens the top row, which nought must block
+    BOOST_CHECK(board.get_winning_moves(VALUE::kCross)==position_mask(POSITION::kTopRight));
+    BOOST_CHECK(board.get_blocking_moves(VALUE::kNought)==position_mask(POSITION::kTopRight));
+    BOOST_CHECK(board.get_winning_moves(VALUE::kNought)==0);
+
+    // check blocking removes the threat, and nought now threatens the anti-diagonal
+    board.assign_position(POSITION::kTopRight,VALUE::kNought);
+    BOOST_CHECK(board.get_winning_moves(VALUE::kCross)==0);
+    BOOST_CHECK(board.get_winning_moves(VALUE::kNought)==position_mask(POSITION::kBottomLeft));
+
+    // check undoing a move restores the threats before it, and that several threats are all found
+    board.assign_position(POSITION::kMiddleLeft,VALUE::kCross);
+    BOOST_CHECK(board.get_winning_moves(VALUE::kCross)==position_mask(POSITION::kBottomLeft));
+    board.unmake_move(POSITION::kMiddleLeft);
+    board.assign_position(POSITION::kBottomRight,VALUE::kCross);
+    BOOST_CHECK(board.get_winning_moves(VALUE::kNought)==position_mask(POSITION::kBottomLeft));
+    board.unmake_move(POSITION::kBottomRight);
+    board.assign_position(POSITION::kBottomMiddle,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleRight,VALUE::kNought);
+    BOOST_CHECK(board.get_winning_moves(VALUE::kNought)==(position_mask(POSITION::kBottomLeft)|position_mask(POSITION::kMiddleLeft)
+      |position_mask(POSITION::kBottomRight)));
+
+    // check threats match those found line by line on every legal board, moved by every isometry
+    for (int index=0;index<kLegalPositions;++index)
+    {
+      const Board legal=Board::from_legal_index(index);
+      for (int itr=0;itr<kIsometries;++itr)
+      {
+        const Board moved=(legal>>itr/4)<<itr%4;
+        for (const VALUE val:{VALUE::kCross,VALUE::kNought})
+        {
+          board_mask wins=0;
+          for (const board_mask line:kWinningMasks)
+          {
+            const board_mask own=moved.get_mask(val),other=moved.get_mask(opposite(val));
+            if (popcount(own&line)==2&&(other&line)==0) { wins|=line&moved.get_empty(); }
+          }
+          BOOST_CHECK(moved.get_winning_moves(val)==wins);
+        }
+      }
+    }
+
+    // check the threats of a larger board
+    BasicBoard<5,5,4> large;
+    for (const int pos:{0,6,12}) { large.assign_position(static_cast<POSITION>(pos),VALUE::kCross); }
+    BOOST_CHECK((large.get_winning_moves(VALUE::kCross)==BasicBoard<5,5,4>::position_mask(static_cast<POSITION>(18))));
+    large.assign_position(static_cast<POSITION>(18),VALUE::kNought);
+    BOOST_CHECK(large.get_winning_moves(VALUE::kCross)==0);
+  }
+
   // test the comparison operator
   BOOST_AUTO_TEST_CASE(comparison)
   {
@@ -400,6 +833,218 @@ BOOST_AUTO_TEST_SUITE(test_board)
     BOOST_CHECK(!(board_one==board_two));
   }
 
+  // test the canonical key
+  BOOST_AUTO_TEST_CASE(canonical_key)
+  {
+    // check each isometry is undone by its inverse, and the identity is the identity
+    for (int itr=0;itr<kIsometries;++itr)
+    {
+      for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+      {
+        BOOST_CHECK(apply_isometry(apply_isometry(pos,itr),kInverseIsometries[itr])==pos);
+        BOOST_CHECK(apply_isometry(position_mask(pos),itr)==position_mask(apply_isometry(pos,itr)));
+      }
+    }
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos) { BOOST_CHECK(apply_isometry(pos,0)==pos); }
+
+    // check the isometries match the operators
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleRight,VALUE::kNought);
+    board.assign_position(POSITION::kBottomMiddle,VALUE::kCross);
+    for (int itr=0;itr<kIsometries;++itr)
+    {
+      const Board moved=(board>>(itr/4))<<(itr%4);
+      BOOST_CHECK(moved.get_mask(VALUE::kCross)==apply_isometry(board.get_mask(VALUE::kCross),itr));
+      BOOST_CHECK(moved.get_mask(VALUE::kNought)==apply_isometry(board.get_mask(VALUE::kNought),itr));
+      // check every isometry has the same key
+      BOOST_CHECK(moved.canonical_key().key==board.canonical_key().key);
+    }
+
+    // check the isometry of the key takes the board to its canonical form, and moves can be mapped back
+    const CanonicalKey canonical=board.canonical_key();
+    const board_mask crosses=apply_isometry(board.get_mask(VALUE::kCross),canonical.isometry)
+      ,noughts=apply_isometry(board.get_mask(VALUE::kNought),canonical.isometry);
+    BOOST_CHECK(canonical.key==(crosses|static_cast<std::uint32_t>(noughts)<<9));
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      const POSITION canonical_pos=apply_isometry(pos,canonical.isometry);
+      BOOST_CHECK(apply_isometry(canonical_pos,kInverseIsometries[canonical.isometry])==pos);
+      BOOST_CHECK(board[pos]==(crosses&position_mask(canonical_pos) ? VALUE::kCross :
+        noughts&position_mask(canonical_pos) ? VALUE::kNought : VALUE::kEmpty));
+    }
+
+    // check there are 765 classes of isometries among all boards reachable in a game
+    std::set<std::uint32_t> keys;
+    std::function<void(Board &)> play=[&](Board &state)
+    {
+      keys.insert(state.canonical_key().key);
+      if (state.check_board()!=RESULT::kNotWon) { return; }
+      for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+      {
+        if (state[pos]!=VALUE::kEmpty) { continue; }
+        state.make_move(pos,state.get_plays()%2==0 ? VALUE::kCross : VALUE::kNought);
+        play(state);
+        state.unmake_move(pos);
+      }
+    };
+    Board empty;
+    play(empty);
+    BOOST_CHECK(keys.size()==765);
+  }
+
+  // test ranking and indexing boards
+  BOOST_AUTO_TEST_CASE(ranking)
+  {
+    // check the empty board and the drawn board have the expected ranks
+    Board board;
+    BOOST_CHECK(board.rank()==0);
+    int rank=0;
+    for (POSITION pos=POSITION::kBottomRight;pos>-1;pos=pos-1) { rank=rank*3+static_cast<int>(draw_one.at(static_cast<int>(pos))); }
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos) { board.assign_position(pos,draw_one.at(static_cast<int>(pos))); }
+    BOOST_CHECK(board.rank()==rank);
+
+    // check every rank gives back a board of that rank
+    int legal=0;
+    for (int itr=0;itr<kRanks;++itr)
+    {
+      const Board ranked=Board::from_rank(itr);
+      BOOST_CHECK(ranked.rank()==itr);
+      if (ranked.is_legal())
+      {
+        // check legal boards are indexed in order of rank
+        BOOST_CHECK(ranked.legal_index()==legal);
+        BOOST_CHECK(Board::from_legal_index(legal).rank()==itr);
+        ++legal;
+      }
+      else { BOOST_CHECK(ranked.legal_index()==-1); }
+    }
+    // check the number of legal boards
+    BOOST_CHECK(legal==kLegalPositions);
+
+    // check the board of a rank has the correct result
+    BOOST_CHECK(Board::from_rank(board.rank()).check_board()==RESULT::kDraw);
+    BOOST_CHECK(Board::from_rank(board.rank()).get_plays()==ITERATION::kNine);
+    BOOST_CHECK(Board::from_rank(1+3+9+27+243).check_board()==RESULT::kCross); // crosses on the top row, middle left, and middle right
+    BOOST_CHECK(!Board::from_rank(1+3+9).is_legal()); // crosses on the top row, but nought never played
+
+    // check bounds checking
+    BOOST_CHECK_THROW(Board::from_rank(-1),std::out_of_range);
+    BOOST_CHECK_THROW(Board::from_rank(kRanks),std::out_of_range);
+    BOOST_CHECK_THROW(Board::from_legal_index(-1),std::out_of_range);
+    BOOST_CHECK_THROW(Board::from_legal_index(kLegalPositions),std::out_of_range);
+  }
+
+  // test solving every board
+  BOOST_AUTO_TEST_CASE(solving)
+  {
+    // check boards can be played, moved, and checked in constant expressions
+    constexpr Board won=[]()
+    {
+      Board board;
+      board.make_move_unchecked(POSITION::kTopLeft,VALUE::kCross);
+      board.make_move_unchecked(POSITION::kMiddleLeft,VALUE::kNought);
+      board.make_move_unchecked(POSITION::kTopMiddle,VALUE::kCross);
+      board.make_move_unchecked(POSITION::kMiddleMiddle,VALUE::kNought);
+      board.make_move_unchecked(POSITION::kTopRight,VALUE::kCross);
+      return board<<1;
+    }();
+    static_assert(won.check_board()==RESULT::kCross);
+    static_assert(won.get_turn()==VALUE::kNought);
+    // the top row is turned to the left column
+    static_assert(won.get_mask(VALUE::kCross)==0x49&&won.get_mask(VALUE::kNought)==0x90);
+    static_assert((won>>1).get_mask(VALUE::kCross)==0x124);
+    static_assert(Board().rank()==0&&Board().get_turn()==VALUE::kCross);
+
+    // check the table against a plain negamax over every game
+    const std::array<SolvedPosition,kRanks> &solved=solved_positions();
+    std::set<int> ranks;
+    std::function<int(Board &)> negamax=[&](Board &state)
+    {
+      const int rank=state.rank();
+      ranks.insert(rank);
+      int value=-1;
+      board_mask moves=0;
+      if (state.check_board()!=RESULT::kNotWon) { value=state.check_board()==RESULT::kDraw ? 0 : -1; }
+      else
+      {
+        const VALUE turn=state.get_turn();
+        for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+        {
+          if (state[pos]!=VALUE::kEmpty) { continue; }
+          state.make_move(pos,turn);
+          const int child=-negamax(state);
+          state.unmake_move(pos);
+          if (child>value) { value=child; moves=0; }
+          if (child==value) { moves|=position_mask(pos); }
+        }
+      }
+      BOOST_CHECK(solved[rank].value==value);
+      BOOST_CHECK(solved[rank].moves==moves);
+      return value;
+    };
+    Board board;
+    BOOST_CHECK(negamax(board)==0);
+    // check exactly the boards reachable in a game are solved
+    BOOST_CHECK(ranks.size()==kLegalPositions);
+    for (int itr=0;itr<kRanks;++itr) { BOOST_CHECK((solved[itr].value!=SolvedPosition::kUnsolved)==(ranks.count(itr)==1)); }
+  }
+
+  // test hashing boards
+  BOOST_AUTO_TEST_CASE(hashing)
+  {
+    // check the empty board hashes to 0
+    Board board;
+    BOOST_CHECK(board.hash()==0);
+    BOOST_CHECK(board.symmetric_hash()==0);
+
+    // check assigning and unassigning a position restores the hash, and the incremental hash matches a board built directly
+    for (POSITION pos=POSITION::kTopLeft;pos<=POSITION::kBottomRight;++pos)
+    {
+      const std::uint64_t hash=board.hash(),symmetric_hash=board.symmetric_hash();
+      board.make_move(pos,draw_one.at(static_cast<int>(pos)));
+      BOOST_CHECK(board.hash()!=hash);
+      BOOST_CHECK(board.hash()==Board::from_rank(board.rank()).hash());
+      BOOST_CHECK(board.symmetric_hash()==Board::from_rank(board.rank()).symmetric_hash());
+      board.unmake_move(pos);
+      BOOST_CHECK(board.hash()==hash);
+      BOOST_CHECK(board.symmetric_hash()==symmetric_hash);
+      board.make_move(pos,draw_one.at(static_cast<int>(pos)));
+    }
+    // check clearing the board resets the hash
+    board.clear_board();
+    BOOST_CHECK(board.hash()==0);
+
+    // check all isometries have the same symmetric hash, and the hash of each isometry is the hash of the moved board
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleRight,VALUE::kNought);
+    board.assign_position(POSITION::kBottomMiddle,VALUE::kCross);
+    for (int itr=0;itr<kIsometries;++itr)
+    {
+      const Board moved=(board>>(itr/4))<<(itr%4);
+      BOOST_CHECK(moved.symmetric_hash()==board.symmetric_hash());
+      BOOST_CHECK(moved.hash()==Board::from_rank(moved.rank()).hash());
+    }
+    // check moving each position by the symmetric isometry gives the board whose hash is the symmetric hash
+    Board moved;
+    for (const POSITION pos:{POSITION::kTopLeft,POSITION::kMiddleRight,POSITION::kBottomMiddle})
+    {
+      moved.assign_position(Board::apply_isometry(pos,board.symmetric_isometry()),board[pos]);
+    }
+    BOOST_CHECK(moved.hash()==board.symmetric_hash());
+
+    // check hashes distinguish every legal board, and symmetric hashes every class of isometries
+    std::set<std::uint64_t> hashes,symmetric_hashes;
+    for (int itr=0;itr<kLegalPositions;++itr)
+    {
+      const Board legal=Board::from_legal_index(itr);
+      hashes.insert(legal.hash());
+      symmetric_hashes.insert(legal.symmetric_hash());
+    }
+    BOOST_CHECK(hashes.size()==kLegalPositions);
+    BOOST_CHECK(symmetric_hashes.size()==765);
+  }
+
   // test swap function (and implicitly the move constructor)
   BOOST_AUTO_TEST_CASE(swapping)
   {
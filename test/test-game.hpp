@@ -181,5 +181,39 @@ BOOST_AUTO_TEST_SUITE(test_game)
     }
   }
 
+  // test game play without exceptions
+  BOOST_AUTO_TEST_CASE(try_game_play)
+  {
+    Board board;
+    Player player_one(VALUE::kCross,board),player_two(VALUE::kNought,board);
+    Game game(board,&player_one,&player_two,GAME::kPvP);
+    for (int itr=0;itr<9;++itr)
+    {
+      // check a filled position is reported and does not count as a play
+      if (itr>0) { BOOST_CHECK(game.try_play(draw_one[itr-1])==ASSIGNMENT::kNonEmptyPosition); }
+      BOOST_CHECK(game.get_plays()==itr);
+      // check the move is made by the right player
+      BOOST_CHECK(game.try_play(draw_one[itr])==ASSIGNMENT::kAssigned);
+      BOOST_CHECK(board[draw_one[itr]]==(itr%2==0 ? VALUE::kCross : VALUE::kNought));
+    }
+    BOOST_CHECK(board.check_board()==RESULT::kDraw);
+  }
+
+  // test game play on a larger board
+  BOOST_AUTO_TEST_CASE(generic_game_play)
+  {
+    BasicBoard<7,7,5> board;
+    BasicRandom<7,7,5> player_one(VALUE::kCross,board),player_two(VALUE::kNought,board);
+    BasicGame<7,7,5> game(board,&player_one,&player_two,GAME::kRvR);
+    // check random players can finish the game
+    while (board.check_board()==RESULT::kNotWon)
+    {
+      BasicRandom<7,7,5> &player=static_cast<int>(game.get_plays())%2==0 ? player_one : player_two;
+      BOOST_CHECK_NO_THROW(game.play(player.get_move()));
+    }
+    const int plays=static_cast<int>(game.get_plays());
+    BOOST_CHECK(plays>=9&&plays<=49);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 }
@@ -274,5 +274,14 @@ BOOST_AUTO_TEST_SUITE(test_menace)
     BOOST_CHECK(kRandomSecondGames.at(2)==GAME::kMvR);
   }
 
+  // test the value of the other side
+  BOOST_AUTO_TEST_CASE(opposite_value)
+  {
+    static_assert(opposite(VALUE::kCross)==VALUE::kNought);
+    static_assert(opposite(VALUE::kNought)==VALUE::kCross);
+    // check opposing twice gives the same side
+    BOOST_CHECK(opposite(opposite(VALUE::kCross))==VALUE::kCross);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 }
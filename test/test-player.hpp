@@ -9,6 +9,11 @@
 // Test file for the Player classes of MENACE
 
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <vector>
+
 #include <player.hpp>
 
 namespace PlayerTesting
@@ -19,6 +24,71 @@ const std::array<VALUE,9> draw_one={
   VALUE::kCross,VALUE::kNought,VALUE::kCross,VALUE::kCross,VALUE::kNought,VALUE::kCross,VALUE::kNought,VALUE::kCross,VALUE::kNought
 };
 
+// a board with crosses and noughts on the given positions
+template <int M, int N, int K>
+BasicBoard<M,N,K> make_board(const std::vector<int> &crosses, const std::vector<int> &noughts)
+{
+  BasicBoard<M,N,K> board;
+  for (const int pos:crosses) { board.assign_position(static_cast<POSITION>(pos),VALUE::kCross); }
+  for (const int pos:noughts) { board.assign_position(static_cast<POSITION>(pos),VALUE::kNought); }
+  return board;
+}
+
+// a 4x4 board on which cross, to move, wins on the anti-diagonal at 6, where nought would otherwise win, so every other move loses
+BasicBoard<4,4,3> make_forced_board(void)
+{
+  return make_board<4,4,3>({0,1,9,12,15},{2,3,4,5,10});
+}
+
+// boards on which cross is to move and neither side can complete a line, with moves of more than one value, deep enough for the
+// searches to split, re-search, and deepen
+BasicBoard<4,4,3> make_quiet_board(void)
+{
+  return make_board<4,4,3>({11,12},{0,15});
+}
+
+BasicBoard<5,5,4> make_quiet_large_board(void)
+{
+  return make_board<5,5,4>({6,7,13,15,22},{5,8,9,12,24});
+}
+
+// the value of each move of an evaluation, or the minimum integer for positions which are not moves
+template <int M, int N, int K>
+std::array<int,BasicBoard<M,N,K>::kPositions> move_values(const std::vector<MoveEvaluation> &evaluation)
+{
+  std::array<int,BasicBoard<M,N,K>::kPositions> values;
+  std::fill(std::begin(values),std::end(values),std::numeric_limits<int>::min());
+  for (const MoveEvaluation &move:evaluation) { values[static_cast<int>(move.pos)]=move.value; }
+  return values;
+}
+
+// check every search and driver values each move of a board as a serial search with plain alpha-beta does, and plays one of the
+// best, searching to the end of the game at once without a budget of boards, or deepening one move at a time with one
+template <int M, int N, int K>
+void check_search_values(BasicBoard<M,N,K> &board, const std::uint64_t nodes)
+{
+  BasicMENACE<M,N,K> serial(VALUE::kCross,board);
+  const std::array<int,BasicBoard<M,N,K>::kPositions> expected=move_values<M,N,K>(serial.evaluate_moves());
+  const int best=*std::max_element(std::cbegin(expected),std::cend(expected));
+  for (const SEARCH search:{SEARCH::kSerial,SEARCH::kRoot,SEARCH::kYoungBrothers,SEARCH::kLazySMP})
+  {
+    for (const DRIVER driver:{DRIVER::kAlphaBeta,DRIVER::kPrincipalVariation,DRIVER::kAspiration,DRIVER::kMTDf})
+    {
+      BasicMENACE<M,N,K> player(VALUE::kCross,board);
+      // three threads, so SEARCH::kLazySMP has helpers at both depths
+      player.set_search(search,3);
+      player.set_driver(driver);
+      player.set_limits(std::chrono::milliseconds(0),nodes);
+      BOOST_CHECK((move_values<M,N,K>(player.evaluate_moves())==expected));
+      // a search which deepens stops once every value is a win or a loss, which searching deeper cannot change
+      BOOST_CHECK(nodes==0 ? player.get_depth()==popcount(board.get_empty()) : player.get_depth()>=1);
+      player.clear_tansposition_table();
+      BOOST_CHECK(expected[static_cast<int>(player.get_move())]==best);
+      BOOST_CHECK(player.get_nodes()>0);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(test_player)
 
   // test initialising player objects
@@ -117,6 +187,296 @@ BOOST_AUTO_TEST_SUITE(test_menace)
     }
   }
 
+  // test MENACE only plays the optimal moves of the table of solved positions
+  BOOST_AUTO_TEST_CASE(solved_moves)
+  {
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleLeft,VALUE::kNought);
+    board.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    MENACE player=MENACE(VALUE::kCross,board);
+    // check cross completes the top row rather than block nought
+    for (int itr=0;itr<10;++itr) { BOOST_CHECK(player.get_move()==POSITION::kTopRight); }
+
+    // check out of turn, MENACE still finds an empty position by search
+    MENACE other=MENACE(VALUE::kNought,board);
+    const POSITION pos=other.get_move();
+    BOOST_CHECK(board[pos]==VALUE::kEmpty);
+  }
+
+  // test MENACE values every move, and the moves expected to follow each
+  BOOST_AUTO_TEST_CASE(evaluated_moves)
+  {
+    // check the table of solved positions values a draw of every opening move, each played out to a full board
+    Board empty;
+    MENACE opening=MENACE(VALUE::kCross,empty);
+    std::vector<MoveEvaluation> evaluation=opening.evaluate_moves(true);
+    BOOST_CHECK(evaluation.size()==9);
+    for (const MoveEvaluation &move:evaluation)
+    {
+      BOOST_CHECK(move.value==0);
+      BOOST_CHECK(move.variation.size()==9);
+      BOOST_CHECK(move.variation.front()==move.pos);
+    }
+    BOOST_CHECK(opening.evaluate_moves().front().variation.empty());
+
+    // check a win is valued above a block, and a move which neither wins nor blocks loses to the completed line
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleLeft,VALUE::kNought);
+    board.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    MENACE player=MENACE(VALUE::kCross,board);
+    evaluation=player.evaluate_moves(true);
+    BOOST_CHECK(evaluation.size()==5);
+    BOOST_CHECK(evaluation.front().pos==POSITION::kTopRight);
+    BOOST_CHECK(evaluation.front().value==MENACE::kWin);
+    BOOST_CHECK(evaluation.front().variation==std::vector<POSITION>{POSITION::kTopRight});
+    for (const MoveEvaluation &move:evaluation)
+    {
+      if (move.pos!=POSITION::kTopRight&&move.pos!=POSITION::kMiddleRight)
+      {
+        BOOST_CHECK(move.value==-MENACE::kWin);
+        BOOST_CHECK(move.variation==(std::vector<POSITION>{move.pos,POSITION::kMiddleRight}));
+      }
+    }
+    // check the evaluation gives the move
+    for (int itr=0;itr<10;++itr) { BOOST_CHECK(MENACE::choose_move(evaluation)==POSITION::kTopRight); }
+    BOOST_CHECK_THROW(MENACE::choose_move({}),std::invalid_argument);
+
+    // check a search values every move exactly, not only the best, by each search and however deep it goes
+    BasicBoard<4,4,3> large=make_forced_board();
+    BasicMENACE<4,4,3> searcher(VALUE::kCross,large);
+    constexpr int kWin=BasicMENACE<4,4,3>::kWin;
+    for (const SEARCH search:{SEARCH::kSerial,SEARCH::kRoot,SEARCH::kYoungBrothers,SEARCH::kLazySMP})
+    {
+      for (const std::uint64_t nodes:{std::uint64_t{0},std::uint64_t{1}<<20})
+      {
+        searcher.clear_tansposition_table();
+        searcher.set_search(search,2);
+        searcher.set_limits(std::chrono::milliseconds(0),nodes);
+        const std::vector<MoveEvaluation> values=searcher.evaluate_moves(true);
+        BOOST_CHECK(values.size()==static_cast<size_t>(popcount(large.get_empty())));
+        BOOST_CHECK(static_cast<int>(values.front().pos)==6);
+        BOOST_CHECK(values.front().value==kWin);
+        for (size_t itr=1;itr<values.size();++itr)
+        {
+          // nought completes the line cross did not
+          BOOST_CHECK(values[itr].value==-kWin);
+          BOOST_CHECK(values[itr].variation.size()==2);
+          BOOST_CHECK(values[itr].variation.front()==values[itr].pos);
+          BOOST_CHECK(large[values[itr].variation.back()]==VALUE::kEmpty);
+        }
+      }
+    }
+  }
+
+  // test MENACE searches boards of other sizes
+  BOOST_AUTO_TEST_CASE(generic_moves)
+  {
+    BasicBoard<4,4,3> board=make_forced_board();
+    BasicMENACE<4,4,3> player(VALUE::kCross,board);
+    // check cross completes the anti-diagonal, the only move which does not lose
+    for (int itr=0;itr<10;++itr) { BOOST_CHECK(static_cast<int>(player.get_move())==6); }
+  }
+
+  // test MENACE reports the work of its searches
+  BOOST_AUTO_TEST_CASE(search_nodes)
+  {
+    Board board;
+    MENACE player(VALUE::kNought,board);
+    // check nothing is searched before a move is asked for, nor when the move is in the table of solved positions
+    BOOST_CHECK(player.get_nodes()==0);
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    player.get_move();
+    BOOST_CHECK(player.get_nodes()==0);
+
+    // check a search out of turn visits boards, but fewer than the 8!/1! boards of the full game tree below the first move
+    MENACE other(VALUE::kCross,board);
+    const POSITION pos=other.get_move();
+    BOOST_CHECK(board[pos]==VALUE::kEmpty);
+    BOOST_CHECK(other.get_nodes()>0);
+    BOOST_CHECK(other.get_nodes()<40320);
+
+    // check a second search of the same board is settled by the transposition table, one board per distinct move
+    other.get_move();
+    BOOST_CHECK(other.get_nodes()==static_cast<std::uint64_t>(popcount(board.get_distinct_empty())));
+    BOOST_CHECK(other.get_nodes()==5);
+  }
+
+  // test MENACE's values do not depend on how its search is spread over threads, nor how each move is searched for
+  BOOST_AUTO_TEST_CASE(parallel_search)
+  {
+    BasicBoard<4,4,3> board=make_quiet_board();
+    check_search_values(board,0);
+    BasicBoard<5,5,4> large=make_quiet_large_board();
+    check_search_values(large,0);
+
+    // check searches must have threads
+    BasicMENACE<4,4,3> player(VALUE::kCross,board);
+    BOOST_CHECK_THROW(player.set_search(SEARCH::kRoot,0),std::invalid_argument);
+  }
+
+  // test MENACE's values do not depend on how each move is searched for when deepening one move at a time, guided by the values of
+  // the last iteration
+  BOOST_AUTO_TEST_CASE(search_drivers)
+  {
+    BasicBoard<4,4,3> board=make_quiet_board();
+    check_search_values(board,std::uint64_t{1}<<24);
+    BasicBoard<5,5,4> large=make_quiet_large_board();
+    check_search_values(large,std::uint64_t{1}<<24);
+  }
+
+  // test MENACE keeps to the limits of its searches, and still plays well within them
+  BOOST_AUTO_TEST_CASE(limited_search)
+  {
+    // check a search without limits looks to the end of the game
+    BasicBoard<5,5,4> board=make_quiet_large_board();
+    BasicMENACE<5,5,4> player(VALUE::kCross,board);
+    BOOST_CHECK(player.get_depth()==0);
+    const std::array<int,BasicBoard<5,5,4>::kPositions> values=move_values<5,5,4>(player.evaluate_moves());
+    const int best=*std::max_element(std::cbegin(values),std::cend(values));
+    BOOST_CHECK(player.get_depth()==popcount(board.get_empty()));
+    // check a limited search stops short of the end of the game when its boards run out, but has looked ahead
+    player.clear_tansposition_table();
+    player.set_limits(std::chrono::milliseconds(0),4096);
+    BOOST_CHECK(board[player.get_move()]==VALUE::kEmpty);
+    BOOST_CHECK(player.get_nodes()<4096+1024);
+    BOOST_CHECK(player.get_depth()>=1);
+    BOOST_CHECK(player.get_depth()<popcount(board.get_empty()));
+    // check a limited search with boards enough deepens until the best move is settled, and plays one of the best moves
+    player.clear_tansposition_table();
+    player.set_limits(std::chrono::milliseconds(0),std::uint64_t{1}<<24);
+    BOOST_CHECK(values[static_cast<int>(player.get_move())]==best);
+    BOOST_CHECK(player.get_depth()>1);
+
+    // check a search of a board far too large to search to the end keeps to its number of boards, one interval per thread over
+    BasicBoard<7,7,5> large;
+    BasicMENACE<7,7,5> budget(VALUE::kCross,large);
+    for (const int threads:{1,2})
+    {
+      budget.set_search(SEARCH::kYoungBrothers,threads);
+      budget.set_limits(std::chrono::milliseconds(0),20000);
+      BOOST_CHECK(large[budget.get_move()]==VALUE::kEmpty);
+      BOOST_CHECK(budget.get_nodes()<20000+static_cast<std::uint64_t>(threads)*1024);
+      BOOST_CHECK(budget.get_depth()>=1);
+      BOOST_CHECK(budget.get_depth()<popcount(large.get_empty()));
+    }
+
+    // check a search keeps to its time, allowing for the interval between checks of the clock
+    BasicMENACE<7,7,5> timed(VALUE::kCross,large);
+    timed.set_limits(std::chrono::milliseconds(50),0);
+    const std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+    BOOST_CHECK(large[timed.get_move()]==VALUE::kEmpty);
+    BOOST_CHECK(std::chrono::steady_clock::now()-start<std::chrono::milliseconds(1000));
+
+    // check a time cannot be negative
+    BOOST_CHECK_THROW(timed.set_limits(std::chrono::milliseconds(-1),0),std::invalid_argument);
+  }
+
+  // test searches can be stopped from outside
+  BOOST_AUTO_TEST_CASE(stopped_search)
+  {
+    // a board far too large to search to the end, searched without limits
+    BasicBoard<7,7,5> large;
+    BasicMENACE<7,7,5> player(VALUE::kCross,large);
+    const StopToken token=player.get_stop_token();
+
+    // check a search asked to return before it starts gives a legal move, and the request is withdrawn after
+    token.request(STOP::kReturn);
+    BOOST_CHECK(large[player.get_move()]==VALUE::kEmpty);
+    BOOST_CHECK(token.requested()==STOP::kNone);
+
+    // check a search asked to abort gives nothing, and the request is withdrawn after
+    token.request(STOP::kAbort);
+    BOOST_CHECK_THROW(player.get_move(),search_aborted);
+    BOOST_CHECK(token.requested()==STOP::kNone);
+
+    // check a running search is stopped soon after it is asked, by each search
+    for (const SEARCH search:{SEARCH::kSerial,SEARCH::kRoot,SEARCH::kYoungBrothers,SEARCH::kLazySMP})
+    {
+      player.set_search(search,2);
+      const std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+      std::thread stopper([&token]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        token.request(STOP::kReturn);
+      });
+      BOOST_CHECK(large[player.get_move()]==VALUE::kEmpty);
+      stopper.join();
+      BOOST_CHECK(std::chrono::steady_clock::now()-start<std::chrono::milliseconds(1000));
+      BOOST_CHECK(token.requested()==STOP::kNone);
+    }
+  }
+
+  // test MENACE searches on its opponent's time, and keeps the search if they make the move it expected
+  BOOST_AUTO_TEST_CASE(pondered_search)
+  {
+    // check nothing is pondered on MENACE's own turn, nor on the 3x3 board, whose boards are in the table of solved positions
+    Board board;
+    MENACE solved=MENACE(VALUE::kNought,board);
+    solved.ponder();
+    BOOST_CHECK(!solved.get_expected_move());
+    BasicBoard<7,7,5> large;
+    BasicMENACE<7,7,5> player(VALUE::kCross,large);
+    player.ponder();
+    BOOST_CHECK(!player.get_expected_move());
+
+    // the move is chosen within a budget of boards, one interval per thread over
+    constexpr std::uint64_t kBudget=20000;
+    player.set_limits(std::chrono::milliseconds(0),kBudget);
+    large.assign_position(player.get_move(),VALUE::kCross);
+    // a board with every symmetry, so the opponent has moves which are symmetric to the one expected but not the same
+    BasicBoard<7,7,5> centred;
+    centred.assign_position(static_cast<POSITION>(24),VALUE::kCross);
+    for (const int reply_type:{0,1,2})
+    {
+      BasicBoard<7,7,5> copy=centred;
+      BasicMENACE<7,7,5> ponderer(VALUE::kCross,copy);
+      ponderer.set_limits(std::chrono::milliseconds(0),kBudget);
+      ponderer.ponder();
+      BOOST_REQUIRE(ponderer.get_expected_move());
+      const POSITION guess=*ponderer.get_expected_move();
+      BOOST_CHECK(copy[guess]==VALUE::kEmpty);
+      // the opponent takes some time over their move
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      // the move expected, a move symmetric to it on another position, or a move which is neither
+      POSITION reply=guess;
+      if (reply_type==1)
+      {
+        for (int iso=0;iso<BasicBoard<7,7,5>::kIsometries&&reply==guess;++iso) { reply=BasicBoard<7,7,5>::apply_isometry(guess,iso); }
+        BOOST_REQUIRE(reply!=guess);
+      }
+      else if (reply_type==2)
+      {
+        for (const POSITION pos:MoveList<BasicBoard<7,7,5>::kPositions>(copy.get_distinct_empty()))
+        {
+          if (pos!=guess) { reply=pos; break; }
+        }
+      }
+      copy.assign_position(reply,VALUE::kNought);
+      BOOST_CHECK(copy[ponderer.get_move()]==VALUE::kEmpty);
+      BOOST_CHECK(!ponderer.get_expected_move());
+      // check the search on the opponent's time is kept when they make the move expected, and its budget runs from their move,
+      // but is thrown away when they do not, even for a move which gives the same board up to an isometry
+      if (reply_type==0) { BOOST_CHECK(ponderer.get_nodes()>kBudget); }
+      else { BOOST_CHECK(ponderer.get_nodes()<kBudget+1024); }
+    }
+
+    // check pondering can be stopped, leaving no request to stop the next search, and is stopped when MENACE goes
+    BasicMENACE<7,7,5> stopped(VALUE::kCross,large);
+    stopped.ponder();
+    BOOST_CHECK(stopped.get_expected_move());
+    stopped.stop_pondering();
+    BOOST_CHECK(!stopped.get_expected_move());
+    BOOST_CHECK(stopped.get_stop_token().requested()==STOP::kNone);
+    {
+      BasicMENACE<7,7,5> discarded(VALUE::kCross,large);
+      discarded.ponder();
+    }
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(test_random)
@@ -0,0 +1,157 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// test-positionmap.hpp                                                                                                                  //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Test file for the PositionMap class of MENACE
+
+
+#include <positionmap.hpp>
+
+namespace PositionMapTesting
+{
+using namespace menace;
+
+BOOST_AUTO_TEST_SUITE(test_positionmap)
+
+  // test the class index of legal boards
+  BOOST_AUTO_TEST_CASE(class_index)
+  {
+    // check every class is reached, and boards which match under an isometry share their class
+    std::array<int,kIsometryClasses> sizes{};
+    for (int index=0;index<kLegalPositions;++index)
+    {
+      const Board board=Board::from_legal_index(index);
+      const int cls=board.class_index();
+      BOOST_CHECK(cls>=0&&cls<kIsometryClasses);
+      ++sizes[cls];
+      for (int itr=0;itr<kIsometries;++itr) { BOOST_CHECK(((board>>itr/4)<<itr%4).class_index()==cls); }
+      // check the smallest board of the class has the smallest rank
+      BOOST_CHECK(Board::from_class_index(cls).rank()<=board.rank());
+      BOOST_CHECK(Board::from_class_index(cls).class_index()==cls);
+    }
+    BOOST_CHECK(std::find(std::cbegin(sizes),std::cend(sizes),0)==std::cend(sizes));
+    // check the empty board is alone in its class, and a corner is one of four
+    BOOST_CHECK(Board().class_index()==0&&sizes[0]==1);
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    BOOST_CHECK(sizes[board.class_index()]==4);
+
+    // check boards which cannot be reached have no class
+    board.assign_position(POSITION::kTopMiddle,VALUE::kCross);
+    BOOST_CHECK(board.class_index()==-1);
+    BOOST_CHECK_THROW(Board::from_class_index(kIsometryClasses),std::out_of_range);
+    BOOST_CHECK_THROW(Board::from_class_index(-1),std::out_of_range);
+  }
+
+  // test inserting, finding, and erasing values
+  BOOST_AUTO_TEST_CASE(lookup)
+  {
+    PositionMap<int> map;
+    Board board;
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.find(board)==nullptr);
+    BOOST_CHECK_THROW(static_cast<void>(map.at(board)),std::out_of_range);
+
+    // check inserting does not overwrite
+    BOOST_CHECK(map.insert(board,1));
+    BOOST_CHECK(!map.insert(board,2));
+    BOOST_CHECK(map.at(board)==1);
+    BOOST_CHECK(map.size()==1);
+
+    // check the subscript operator inserts once
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kCross);
+    BOOST_CHECK(!map.contains(board));
+    map[board]+=5;
+    map[board]+=5;
+    BOOST_CHECK(*map.find(board)==10);
+    BOOST_CHECK(map.size()==2);
+
+    // check a board which cannot be reached can be indexed by rank
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    BOOST_CHECK(map.insert(board,3));
+    BOOST_CHECK(map.contains(board));
+
+    // check erasing removes the value only
+    BOOST_CHECK(map.erase(board));
+    BOOST_CHECK(!map.erase(board));
+    BOOST_CHECK(!map.contains(board));
+    BOOST_CHECK(map.size()==2);
+
+    // check clearing removes everything
+    map.clear();
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(!map.contains(Board()));
+  }
+
+  // test maps indexed by legal index and by class
+  BOOST_AUTO_TEST_CASE(indexing)
+  {
+    static_assert(PositionMap<int,INDEXING::kRank>::kSize==kRanks);
+    static_assert(PositionMap<int,INDEXING::kLegal>::kSize==kLegalPositions);
+    static_assert(PositionMap<int,INDEXING::kClass>::kSize==kIsometryClasses);
+
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    PositionMap<int,INDEXING::kLegal> legal;
+    PositionMap<int,INDEXING::kClass> classes;
+    legal[board]=1;
+    classes[board]=1;
+
+    // check a rotated board is a different legal board, but in the same class
+    const Board rotated=board<<1;
+    BOOST_CHECK(!legal.contains(rotated));
+    BOOST_CHECK(classes.contains(rotated));
+    BOOST_CHECK(classes.at(rotated)==1);
+
+    // check boards which cannot be reached have no index
+    board.assign_position(POSITION::kTopRight,VALUE::kCross);
+    BOOST_CHECK(!legal.contains(board));
+    BOOST_CHECK(legal.find(board)==nullptr);
+    BOOST_CHECK(!legal.erase(board));
+    BOOST_CHECK_THROW(static_cast<void>(legal[board]),std::out_of_range);
+    BOOST_CHECK_THROW(classes.insert(board,1),std::out_of_range);
+  }
+
+  // test iterating over a map
+  BOOST_AUTO_TEST_CASE(iteration)
+  {
+    PositionMap<int,INDEXING::kClass> map;
+    // check an empty map has nothing to iterate over
+    BOOST_CHECK(map.begin()==map.end());
+
+    // fill every class reached after two moves, in reverse
+    for (int index=kLegalPositions-1;index>=0;--index)
+    {
+      const Board board=Board::from_legal_index(index);
+      if (board.get_plays()==ITERATION::kTwo) { map[board]+=1; }
+    }
+    // there are 12 classes with one cross and one nought
+    BOOST_CHECK(map.size()==12);
+
+    // check iteration is in index order, and reaches the values
+    int count=0,previous=-1,total=0;
+    for (const PositionMapElement<int> &elem:map)
+    {
+      BOOST_CHECK(elem.index>previous);
+      BOOST_CHECK(elem.board.get_plays()==ITERATION::kTwo);
+      BOOST_CHECK(elem.board.class_index()==elem.index);
+      previous=elem.index;
+      total+=elem.value;
+      elem.value=0;
+      ++count;
+    }
+    BOOST_CHECK(count==12);
+    // every board with one cross and one nought, 9*8
+    BOOST_CHECK(total==72);
+
+    // check a const map is iterated over the same
+    const PositionMap<int,INDEXING::kClass> &cmap=map;
+    BOOST_CHECK(std::distance(cmap.begin(),cmap.end())==12);
+    for (const PositionMapElement<const int> &elem:cmap) { BOOST_CHECK(elem.value==0); }
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace PositionMapTesting
@@ -0,0 +1,73 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// test-threadpool.hpp                                                                                                                   //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Test file for the thread pool of MENACE
+
+
+#include <array>
+#include <atomic>
+
+#include <threadpool.hpp>
+
+namespace ThreadPoolTesting
+{
+using namespace menace;
+
+BOOST_AUTO_TEST_SUITE(test_threadpool)
+
+  // test each thread runs each job once
+  BOOST_AUTO_TEST_CASE(run)
+  {
+    ThreadPool pool(4);
+    BOOST_CHECK(pool.size()==4);
+    std::array<std::atomic<int>,4> counts{};
+    // check jobs can be given to the pool repeatedly
+    for (int itr=0;itr<50;++itr)
+    {
+      pool.run([&counts](const int thread) { ++counts[thread]; });
+    }
+    for (const std::atomic<int> &count:counts) { BOOST_CHECK(count==50); }
+
+    // check a pool of one thread runs on the calling thread
+    ThreadPool single(1);
+    const std::thread::id caller=std::this_thread::get_id();
+    bool same=false;
+    single.run([&same,caller](const int thread) { same=thread==0&&std::this_thread::get_id()==caller; });
+    BOOST_CHECK(same);
+  }
+
+  // test pools must have threads
+  BOOST_AUTO_TEST_CASE(threads)
+  {
+    BOOST_CHECK_THROW(ThreadPool pool(0),std::invalid_argument);
+    BOOST_CHECK_THROW(ThreadPool pool(-1),std::invalid_argument);
+  }
+
+  // test stop tokens share their request between copies
+  BOOST_AUTO_TEST_CASE(stop_token)
+  {
+    const StopToken token;
+    const StopToken copy=token;
+    BOOST_CHECK(token.requested()==STOP::kNone);
+    copy.request(STOP::kReturn);
+    BOOST_CHECK(token.requested()==STOP::kReturn);
+    // check an abort replaces a return, but not the other way
+    token.request(STOP::kAbort);
+    BOOST_CHECK(copy.requested()==STOP::kAbort);
+    token.request(STOP::kReturn);
+    BOOST_CHECK(copy.requested()==STOP::kAbort);
+    // check a request can be withdrawn
+    copy.reset();
+    BOOST_CHECK(token.requested()==STOP::kNone);
+    // check a token made apart shares nothing
+    const StopToken other;
+    other.request(STOP::kAbort);
+    BOOST_CHECK(token.requested()==STOP::kNone);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace ThreadPoolTesting
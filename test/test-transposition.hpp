@@ -0,0 +1,192 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+//                                                                                                                                       //
+// test-transposition.hpp                                                                                                                //
+//                                                                                                                                       //
+// D. C. Groothuizen Dijkema - November, 2019                                                                                            //
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+//
+
+// Test file for the transposition table of MENACE
+
+
+#include <board.hpp>
+#include <player.hpp>
+#include <threadpool.hpp>
+#include <transposition.hpp>
+
+namespace TranspositionTesting
+{
+using namespace menace;
+
+BOOST_AUTO_TEST_SUITE(test_transposition)
+
+  // test storing and looking up boards
+  BOOST_AUTO_TEST_CASE(lookup)
+  {
+    TranspositionTable table;
+    Board board;
+    board.assign_position(POSITION::kTopLeft,VALUE::kCross);
+    int alpha=-1,beta=1,val=2;
+    // check an empty table has nothing to settle
+    BOOST_CHECK(!table.probe(board.symmetric_hash(),alpha,beta,val));
+    BOOST_CHECK(alpha==-1&&beta==1);
+    BOOST_CHECK(table.size()==0);
+
+    table.store(board.symmetric_hash(),0,BOUND::kExact,8);
+    // check the value is found for the board and all boards which match it under an isometry
+    for (int itr=0;itr<kIsometries;++itr)
+    {
+      const Board other=(board>>itr/4)<<itr%4;
+      alpha=-1,beta=1,val=2;
+      BOOST_CHECK(table.probe(other.symmetric_hash(),alpha,beta,val));
+      BOOST_CHECK(val==0);
+    }
+    BOOST_CHECK(table.size()==1);
+
+    // check a different board is not found
+    board.assign_position(POSITION::kMiddleMiddle,VALUE::kNought);
+    BOOST_CHECK(!table.probe(board.symmetric_hash(),alpha,beta,val));
+
+    // check clearing the table removes the board
+    table.clear();
+    board.unmake_move(POSITION::kMiddleMiddle);
+    BOOST_CHECK(!table.probe(board.symmetric_hash(),alpha,beta,val));
+    BOOST_CHECK(table.size()==0);
+  }
+
+  // test bounds are only used where they settle the value of a board
+  BOOST_AUTO_TEST_CASE(bounds)
+  {
+    TranspositionTable table;
+    const std::uint64_t lower=1,upper=2;
+    table.store(lower,0,BOUND::kLower,5);
+    table.store(upper,0,BOUND::kUpper,5);
+
+    // check a lower bound inside the window raises alpha
+    int alpha=-1,beta=1,val=2;
+    BOOST_CHECK(!table.probe(lower,alpha,beta,val));
+    BOOST_CHECK(alpha==0&&beta==1);
+    // check a lower bound at or above beta settles the value
+    alpha=-1,beta=0;
+    BOOST_CHECK(table.probe(lower,alpha,beta,val));
+    BOOST_CHECK(val==0);
+
+    // check an upper bound inside the window lowers beta
+    alpha=-1,beta=1;
+    BOOST_CHECK(!table.probe(upper,alpha,beta,val));
+    BOOST_CHECK(alpha==-1&&beta==0);
+    // check an upper bound at or below alpha settles the value
+    alpha=0,beta=1;
+    BOOST_CHECK(table.probe(upper,alpha,beta,val));
+    BOOST_CHECK(val==0);
+
+    // check storing again replaces the bound
+    table.store(lower,1,BOUND::kExact,5);
+    alpha=-1,beta=1;
+    BOOST_CHECK(table.probe(lower,alpha,beta,val));
+    BOOST_CHECK(val==1);
+    BOOST_CHECK(table.size()==2);
+  }
+
+  // test values are only used by searches no deeper than the search which found them, but best moves are used by any
+  BOOST_AUTO_TEST_CASE(depths)
+  {
+    TranspositionTable table;
+    table.store(1,0,BOUND::kExact,3,7);
+    int alpha=-1,beta=1,val=2,move=TranspositionTable::kNoMove;
+    // check a search as deep or shallower is settled
+    BOOST_CHECK(table.probe(1,3,alpha,beta,val,move));
+    BOOST_CHECK(val==0&&move==7);
+    BOOST_CHECK(table.probe(1,1,alpha,beta,val,move));
+    // check a deeper search is not, but is given the move
+    move=TranspositionTable::kNoMove;
+    BOOST_CHECK(!table.probe(1,4,alpha,beta,val,move));
+    BOOST_CHECK(move==7);
+    // check an unknown board has no move
+    BOOST_CHECK(!table.probe(2,0,alpha,beta,val,move));
+    BOOST_CHECK(move==TranspositionTable::kNoMove);
+
+    // check storing the board again without a move keeps its move, and storing with one replaces it
+    table.store(1,1,BOUND::kExact,5);
+    BOOST_CHECK(table.probe(1,5,alpha,beta,val,move));
+    BOOST_CHECK(val==1&&move==7);
+    table.store(1,1,BOUND::kExact,5,2);
+    BOOST_CHECK(table.probe(1,5,alpha,beta,val,move));
+    BOOST_CHECK(move==2);
+  }
+
+  // test the table keeps to its memory, and replaces the shallowest and oldest entries first
+  BOOST_AUTO_TEST_CASE(replacement)
+  {
+    // check the table is rounded down to a power of two buckets
+    static_assert(sizeof(TranspositionBucket)==64);
+    BOOST_CHECK(TranspositionTable(3*64).capacity()==8);
+    BOOST_CHECK(TranspositionTable(0).capacity()==4);
+    BOOST_CHECK(TranspositionTable().capacity()==TranspositionTable::kDefaultBytes/16);
+
+    // a table of one bucket, so every key collides
+    TranspositionTable table(64);
+    int alpha=-1,beta=1,val=2;
+    for (std::uint64_t key=0;key<4;++key) { table.store(key,0,BOUND::kExact,static_cast<int>(key)+1); }
+    BOOST_CHECK(table.size()==4);
+    // check the shallowest entry is replaced when the bucket is full
+    table.store(4,0,BOUND::kExact,9);
+    BOOST_CHECK(table.size()==4);
+    BOOST_CHECK(!table.probe(0,alpha,beta,val));
+    for (std::uint64_t key=1;key<5;++key) { BOOST_CHECK(table.probe(key,alpha,beta,val)); }
+
+    // check entries of earlier searches are replaced before deeper entries of this search, unless they have been found again
+    table.new_search();
+    table.new_search();
+    BOOST_CHECK(table.probe(4,alpha,beta,val));
+    table.store(5,0,BOUND::kExact,1);
+    table.store(6,0,BOUND::kExact,1);
+    table.store(7,0,BOUND::kExact,1);
+    BOOST_CHECK(table.probe(4,alpha,beta,val));
+    for (std::uint64_t key=5;key<8;++key) { BOOST_CHECK(table.probe(key,alpha,beta,val)); }
+    for (std::uint64_t key=1;key<4;++key) { BOOST_CHECK(!table.probe(key,alpha,beta,val)); }
+
+    // check the generation wraps without any entry becoming empty
+    for (int itr=0;itr<1000;++itr) { table.new_search(); }
+    BOOST_CHECK(table.size()==4);
+    BOOST_CHECK(table.probe(4,alpha,beta,val));
+  }
+
+  // test threads storing and looking up boards at once never find the wrong value
+  BOOST_AUTO_TEST_CASE(concurrent)
+  {
+    // a small table, so the threads write the same entries
+    TranspositionTable table(1024);
+    table.new_search();
+    std::atomic<int> wrong(0);
+    ThreadPool pool(4);
+    pool.run([&table,&wrong](const int thread)
+    {
+      for (std::uint64_t itr=0;itr<20000;++itr)
+      {
+        // each key has its own value, depth, and bound
+        const std::uint64_t key=(itr*7+static_cast<std::uint64_t>(thread))%512*0x9e3779b97f4a7c15;
+        const int value=static_cast<int>(key%3)-1;
+        table.store(key,value,BOUND::kExact,static_cast<int>(key%16));
+        // the board may have been replaced by another thread since, but if it is found its value must be its own
+        int alpha=-1,beta=1,val=2;
+        if (table.probe(key,alpha,beta,val)&&val!=value) { ++wrong; }
+      }
+    });
+    BOOST_CHECK(wrong==0);
+    BOOST_CHECK(table.size()<=table.capacity());
+  }
+
+  // test MENACE keeps a flat memory footprint on a larger board
+  BOOST_AUTO_TEST_CASE(bounded_search)
+  {
+    BasicBoard<4,4,3> board;
+    // cross in a corner, nought in the centre, leaves a search far larger than a small table
+    board.assign_position(static_cast<POSITION>(0),VALUE::kCross);
+    board.assign_position(static_cast<POSITION>(5),VALUE::kNought);
+    BasicMENACE<4,4,3> player(VALUE::kCross,board,size_t{1}<<12);
+    const POSITION pos=player.get_move();
+    BOOST_CHECK(board[pos]==VALUE::kEmpty);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace TranspositionTesting
@@ -15,4 +15,7 @@
 #include <test-board.hpp>
 #include <test-game.hpp>
 #include <test-player.hpp>
+#include <test-positionmap.hpp>
 #include <test-menace.hpp>
+#include <test-threadpool.hpp>
+#include <test-transposition.hpp>